@@ -18,6 +18,7 @@
 #include "Lib/Environment.hpp"
 #include "Lib/Int.hpp"
 #include "Lib/Portability.hpp"
+#include "Lib/Random.hpp"
 #include "Lib/Stack.hpp"
 #include "Lib/System.hpp"
 #include "Lib/ScopedLet.hpp"
@@ -30,20 +31,27 @@
 #include "Shell/UIHelper.hpp"
 #include "Shell/Normalisation.hpp"
 #include "Shell/Shuffling.hpp"
+#include "Shell/SineUtils.hpp"
 #include "Shell/TheoryFinder.hpp"
 
+#include <chrono>
 #include <limits>
 #include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
 #include <signal.h>
 #include <fstream>
 #include <cstdio>
 #include <random>
 #include <filesystem>
+#include <algorithm>
 //only for detecting number of cores, no threading here!
 #include <thread>
 
+#include "Saturation/LemmaExchange.hpp"
 #include "Saturation/ProvingHelper.hpp"
 
+#include "Kernel/Clause.hpp"
 #include "Kernel/Problem.hpp"
 
 #include "Schedules.hpp"
@@ -58,7 +66,10 @@ using std::cerr;
 using std::endl;
 namespace fs = std::filesystem;
 
-PortfolioMode::PortfolioMode(Problem* problem) : _prb(problem), _slowness(env.options->slowness()) {
+PortfolioMode::PortfolioMode(Problem* problem)
+  : _prb(problem), _slowness(env.options->slowness()), _preprocessingCache(false),
+    _stallLimit(1000l * env.options->portfolioStallLimit()), _progressFd{-1,-1}
+{
   unsigned cores = std::thread::hardware_concurrency();
   cores = cores < 1 ? 1 : cores;
   _numWorkers = std::min(cores, env.options->multicore());
@@ -67,6 +78,31 @@ PortfolioMode::PortfolioMode(Problem* problem) : _prb(problem), _slowness(env.op
     _numWorkers = cores >= 8 ? cores - 2 : cores;
   }
 
+  if (env.options->portfolioPreprocessingCache()) {
+    // workers forked by the snapshot processes must end up as our children
+    _preprocessingCache = System::becomeChildSubreaper();
+    if (!_preprocessingCache && outputAllowed()) {
+      addCommentSignForSZS(cout) << "WARNING: portfolio_preprocessing_cache is not supported on this platform and will be ignored" << endl;
+    }
+  }
+
+  if (_stallLimit) {
+    // neither the workers nor we should ever block on the progress reports
+    if (pipe(_progressFd) == 0) {
+      fcntl(_progressFd[0], F_SETFL, O_NONBLOCK);
+      fcntl(_progressFd[1], F_SETFL, O_NONBLOCK);
+    } else {
+      _stallLimit = 0;
+    }
+  }
+
+  // the workers would not agree on what the symbols introduced for higher-order reasoning mean
+  if (env.options->portfolioLemmaExchange() && !_prb->isHigherOrder() && !Saturation::LemmaExchange::instance()) {
+    if (!Saturation::LemmaExchange::create() && outputAllowed()) {
+      addCommentSignForSZS(cout) << "WARNING: portfolio_lemma_exchange is not supported on this platform and will be ignored" << endl;
+    }
+  }
+
   auto pathGiven = env.options->printProofToFile();
   if(pathGiven.empty())
     // no collision as we can't have the same PID as another Vampire *simultaneously*
@@ -286,6 +322,26 @@ bool PortfolioMode::prepareScheduleAndPerform(const Shell::Property& prop)
     USER_ERROR("The schedule is empty.");
   }
 
+  // build the SInE trigger index once here rather than in every slice using SInE;
+  // the slices inherit it and reuse it as long as their preprocessing has not changed the units
+  // (the slice options are read as in requestFromSnapshot and the conditions are those of Preprocess::preprocess)
+  Options opt;
+  auto usesSine = [&](const std::string& slice) {
+    try {
+      opt.copyValuesFrom(*env.options);
+      opt.readFromEncodedOptions(slice);
+    } catch(Exception&) {
+      // let the child report on the problem
+      return false;
+    }
+    return opt.sineSelection() != Options::SineSelection::OFF || opt.sineToAge() || opt.useSineLevelSplitQueues()
+      || opt.sineToPredLevels() != Options::PredicateSineLevels::OFF;
+  };
+  if (iterTraits(schedule.iter()).any(usesSine)) {
+    TIME_TRACE(TimeTrace::PREPROCESSING);
+    Shell::SineTriggerIndex::forUnits(_prb->units());
+  }
+
   return runScheduleAndRecoverProof(std::move(schedule));
 };
 
@@ -430,11 +486,16 @@ bool PortfolioMode::runSchedule(Schedule schedule) {
   while(remainingTime = env.remainingTime() / 100, remainingTime > 0)
   {
     // running under capacity, wake up more tasks
-    while(processes.size() < _numWorkers)
+    while(processes.size() + pendingSnapshotWorkers() < _numWorkers)
     {
       // after exhaustion we replace the schedule
       // by copies with x2 time limits and do this forever
       if(!it.hasNext()) {
+        if(_stallLimit) {
+          Schedule prioritised;
+          prioritiseByProgress(schedule, prioritised);
+          schedule = prioritised;
+        }
         Schedule next;
         rescaleScheduleLimits(schedule, next, 2.0);
         schedule = next;
@@ -443,21 +504,16 @@ bool PortfolioMode::runSchedule(Schedule schedule) {
       ALWAYS(it.hasNext());
 
       std::string code = it.next();
-      pid_t process = Multiprocessing::instance()->fork();
-      ASS_NEQ(process, -1);
-      if(process == 0)
-      {
-        TIME_TRACE_NEW_ROOT("child process")
-        runSlice(code, remainingTime);
-        ASSERTION_VIOLATION; // should not return
+      if(_preprocessingCache && requestFromSnapshot(code, remainingTime)) {
+        continue;
       }
-      ALWAYS(processes.insert(process));
+      sliceStarted(forkSlice(code, remainingTime), code, processes);
     }
 
     bool exited, signalled;
     int code;
     // sleep until process changes state
-    pid_t process = Multiprocessing::instance()->poll_children(exited, signalled, code);
+    pid_t process = waitForChild(exited, signalled, code);
 
     /*
     cout << "Child " << process
@@ -465,10 +521,22 @@ bool PortfolioMode::runSchedule(Schedule schedule) {
         << " sig " << signalled << " code " << code << endl;
         */
 
+    if(_preprocessingCache && !processes.contains(process)) {
+      // possibly a worker forked by a snapshot, which we have not heard about yet
+      collectSnapshotWorkers(processes);
+      if(!processes.contains(process)) {
+        if(exited || signalled) {
+          snapshotTerminated(process, processes);
+        }
+        continue;
+      }
+    }
+
     // child died, remove it from the pool and check if succeeded
     if(exited)
     {
       ALWAYS(processes.remove(process));
+      sliceTerminated(process);
       if(!code)
       {
         success = true;
@@ -479,17 +547,458 @@ bool PortfolioMode::runSchedule(Schedule schedule) {
       Shell::addCommentSignForSZS(cout);
       cout<<"Child killed by signal " << code << endl;
       ALWAYS(processes.remove(process));
+      sliceTerminated(process);
     }
   }
 
   // kill all running processes first
+  if(_preprocessingCache) {
+    collectSnapshotWorkers(processes);
+    // a later schedule starts its own snapshots, only the failed ones are remembered
+    Stack<PreprocessedSnapshot> failed;
+    for(PreprocessedSnapshot& snapshot : _snapshots) {
+      if(snapshot.pid == -1) {
+        failed.push(std::move(snapshot));
+        continue;
+      }
+      // the whole process group, which includes the workers still being forked
+      Multiprocessing::instance()->killNoCheck(-snapshot.pid, SIGINT);
+      close(snapshot.requestFd);
+      close(snapshot.replyFd);
+    }
+    _snapshots = std::move(failed);
+  }
   decltype(processes)::Iterator killIt(processes);
   while(killIt.hasNext())
     Multiprocessing::instance()->killNoCheck(killIt.next(), SIGINT);
 
+  // and do not leave them behind as zombies
+  Multiprocessing::instance()->waitForAllChildren();
+
   return success;
 }
 
+/**
+ * Fork a worker running the slice @b sliceCode and return its pid.
+ */
+pid_t PortfolioMode::forkSlice(std::string sliceCode, int remainingTime)
+{
+  pid_t process = Multiprocessing::instance()->fork();
+  ASS_NEQ(process, -1);
+  if(process == 0)
+  {
+    TIME_TRACE_NEW_ROOT("child process")
+    runSlice(sliceCode, remainingTime);
+    ASSERTION_VIOLATION; // should not return
+  }
+  return process;
+}
+
+namespace {
+
+// the pipes between the portfolio process and the snapshots only carry small messages,
+// but let's not rely on the writes and reads being atomic
+
+bool writeAll(int fd, const void* buf, size_t len)
+{
+  const char* p = static_cast<const char*>(buf);
+  while(len) {
+    ssize_t res = ::write(fd, p, len);
+    if(res < 0) {
+      if(errno == EINTR) continue;
+      return false;
+    }
+    p += res;
+    len -= res;
+  }
+  return true;
+}
+
+bool readAll(int fd, void* buf, size_t len)
+{
+  char* p = static_cast<char*>(buf);
+  while(len) {
+    ssize_t res = ::read(fd, p, len);
+    if(res < 0 && errno == EINTR) continue;
+    if(res <= 0) return false;
+    p += res;
+    len -= res;
+  }
+  return true;
+}
+
+/** milliseconds on a clock that all the processes on the machine agree on */
+long long monotonicMilliseconds()
+{
+  using namespace std::chrono;
+  return duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+}
+
+/**
+ * Try to have the slice @b sliceCode run by a worker forked from a snapshot process
+ * which has already preprocessed the problem with the options of this slice
+ * (starting one such process, if there is none yet).
+ *
+ * Return false if that is not possible, in which case the slice should be forked directly.
+ */
+bool PortfolioMode::requestFromSnapshot(const std::string& sliceCode, int remainingTime)
+{
+  TIME_TRACE("preprocessing cache");
+
+  std::string key;
+  try {
+    Options opt;
+    opt.copyValuesFrom(*env.options);
+    opt.readFromEncodedOptions(sliceCode);
+    if(env.options->randomizeSeedForPortfolioWorkers() && opt.randomizedPreprocessing()) {
+      // every worker gets its own seed, so nothing to share
+      return false;
+    }
+    key = opt.preprocessingKey();
+  } catch(Exception&) {
+    // let the child report on the problem
+    return false;
+  }
+
+  PreprocessedSnapshot* snapshot = nullptr;
+  for(PreprocessedSnapshot& s : _snapshots) {
+    if(s.key == key) {
+      snapshot = &s;
+      break;
+    }
+  }
+
+  if(!snapshot) {
+    // the snapshots are mostly idle, but each of them holds a copy of the problem
+    if(_snapshots.size() >= _numWorkers) {
+      return false;
+    }
+
+    int request[2], reply[2];
+    if(pipe(request) != 0) {
+      return false;
+    }
+    if(pipe(reply) != 0) {
+      close(request[0]);
+      close(request[1]);
+      return false;
+    }
+
+    pid_t process = Multiprocessing::instance()->fork();
+    ASS_NEQ(process, -1);
+    if(process == 0)
+    {
+      close(request[1]);
+      close(reply[0]);
+      TIME_TRACE_NEW_ROOT("snapshot process")
+      runSnapshot(sliceCode, remainingTime, request[0], reply[1]);
+      ASSERTION_VIOLATION; // should not return
+    }
+    close(request[0]);
+    close(reply[1]);
+    // we will only poll the replies
+    fcntl(reply[0], F_SETFL, O_NONBLOCK);
+
+    _snapshots.push(PreprocessedSnapshot{key, process, request[1], reply[0], {}});
+    snapshot = &_snapshots.top();
+  }
+
+  if(snapshot->pid == -1) {
+    return false;
+  }
+
+  long long deadline = monotonicMilliseconds() + 100ll * remainingTime;
+  unsigned len = sliceCode.size();
+  if(!writeAll(snapshot->requestFd, &deadline, sizeof(deadline)) ||
+     !writeAll(snapshot->requestFd, &len, sizeof(len)) ||
+     !writeAll(snapshot->requestFd, sliceCode.data(), len)) {
+    // the snapshot is gone, we will learn about it when polling for children
+    return false;
+  }
+  snapshot->pending.push_back(sliceCode);
+  return true;
+}
+
+/**
+ * Preprocess the problem for the slice @b sliceCode and then serve the requests
+ * of the portfolio process coming via @b requestFd, forking a worker for each
+ * and reporting its pid via @b replyFd.
+ */
+void PortfolioMode::runSnapshot(std::string sliceCode, int remainingTime, int requestFd, int replyFd)
+{
+  System::registerForSIGHUPOnParentDeath();
+  UIHelper::portfolioParent = false;
+  pid_t portfolioProcess = getppid();
+  // our own process group, inherited by the workers, so that we get killed together
+  setpgid(0, 0);
+  Lib::sealAllocations();
+  Kernel::Clause::sealAllocator();
+
+  // workers start from the options we were given, not from the ones modified below
+  Options baseOpt;
+  baseOpt.copyValuesFrom(*env.options);
+
+  try {
+    Options& opt = *env.options;
+    opt.readFromEncodedOptions(sliceCode);
+    opt.setTimeLimitInDeciseconds(remainingTime);
+    opt.setNormalize(false);
+    opt.setForcedOptionValues();
+    opt.checkGlobalOptionConstraints();
+
+    Timer::reinitialise(false);
+    Saturation::ProvingHelper::runVampirePreprocessing(*_prb, opt);
+    Timer::disableLimitEnforcement();
+  }
+  catch(...) {
+    // the pending slices will be run directly, we can leave the reporting to them
+    System::terminateImmediately(1);
+  }
+
+  long long deadline;
+  unsigned len;
+  while(readAll(requestFd, &deadline, sizeof(deadline)) && readAll(requestFd, &len, sizeof(len))) {
+    std::string code(len, ' ');
+    if(!readAll(requestFd, code.data(), len)) {
+      break;
+    }
+
+    // fork twice so that the worker gets orphaned and adopted by the portfolio process
+    pid_t intermediate = Multiprocessing::instance()->fork();
+    if(intermediate == 0) {
+      intermediate = getpid();
+      pid_t worker = Multiprocessing::instance()->fork();
+      if(worker == 0) {
+        System::waitForParentDeath(intermediate);
+        if(getppid() != portfolioProcess) { // nobody to report to
+          System::terminateImmediately(1);
+        }
+        env.options->copyValuesFrom(baseOpt);
+        TIME_TRACE_NEW_ROOT("child process")
+        runSlice(code, std::max(1ll, (deadline - monotonicMilliseconds()) / 100), true);
+        ASSERTION_VIOLATION; // should not return
+      }
+      System::terminateImmediately(writeAll(replyFd, &worker, sizeof(worker)) ? 0 : 1);
+    }
+    int status;
+    Multiprocessing::instance()->waitForChildTermination(status);
+  }
+  // the portfolio process is done with us
+  System::terminateImmediately(0);
+}
+
+/**
+ * Number of the workers requested from snapshots, but not yet reported.
+ */
+unsigned PortfolioMode::pendingSnapshotWorkers()
+{
+  unsigned res = 0;
+  for(const PreprocessedSnapshot& snapshot : _snapshots) {
+    res += snapshot.pending.size();
+  }
+  return res;
+}
+
+/**
+ * Add to @b processes the workers reported by the snapshots so far.
+ */
+void PortfolioMode::collectSnapshotWorkers(Set<pid_t>& processes)
+{
+  for(PreprocessedSnapshot& snapshot : _snapshots) {
+    pid_t worker;
+    while(!snapshot.pending.empty() && readAll(snapshot.replyFd, &worker, sizeof(worker))) {
+      sliceStarted(worker, snapshot.pending.front(), processes);
+      snapshot.pending.pop_front();
+    }
+  }
+}
+
+/**
+ * Handle the termination of process @b pid, which was not a worker.
+ *
+ * If it was a snapshot, the slices it did not manage to fork get forked directly
+ * and its key is remembered as not worth trying again.
+ * (Otherwise it was an orphan adopted by us, which we can safely ignore.)
+ */
+void PortfolioMode::snapshotTerminated(pid_t pid, Set<pid_t>& processes)
+{
+  for(PreprocessedSnapshot& snapshot : _snapshots) {
+    if(snapshot.pid != pid) {
+      continue;
+    }
+    snapshot.pid = -1;
+    close(snapshot.requestFd);
+    close(snapshot.replyFd);
+
+    int remainingTime = env.remainingTime() / 100;
+    while(!snapshot.pending.empty()) {
+      std::string code = snapshot.pending.front();
+      snapshot.pending.pop_front();
+      if(remainingTime > 0) {
+        sliceStarted(forkSlice(code, remainingTime), code, processes);
+      }
+    }
+    return;
+  }
+}
+
+/**
+ * Register a newly started slice.
+ */
+void PortfolioMode::sliceStarted(pid_t process, const std::string& sliceCode, Set<pid_t>& processes)
+{
+  ALWAYS(processes.insert(process));
+  if(_stallLimit) {
+    _running.set(process, SliceProgress{sliceCode, Timer::elapsedMilliseconds(), 0, 0, 0, false});
+  }
+}
+
+/**
+ * Record how the slice run by the (no longer running) @b process did.
+ */
+void PortfolioMode::sliceTerminated(pid_t process)
+{
+  SliceProgress progress;
+  if(!_stallLimit || !_running.pop(process, progress)) {
+    return;
+  }
+  float rate = -1;
+  if(!progress.preempted) {
+    long elapsed = Timer::elapsedMilliseconds() - progress.startTime;
+    rate = elapsed > 0 ? 1000.0f * progress.activations / elapsed : 0;
+  }
+  _sliceRates.set(sliceWithoutLimits(progress.code), rate);
+}
+
+/**
+ * Wait until a child changes state and return its pid.
+ *
+ * With --portfolio_stall_limit on, keep processing the progress reports
+ * of the running slices in the meantime.
+ */
+pid_t PortfolioMode::waitForChild(bool& exited, bool& signalled, int& code)
+{
+  if(!_stallLimit) {
+    return Multiprocessing::instance()->poll_children(exited, signalled, code);
+  }
+
+  while(true) {
+    pid_t process = Multiprocessing::instance()->poll_children(exited, signalled, code, /*block*/ false);
+    if(process) {
+      return process;
+    }
+    // sleep until a report comes, but check on the children regularly
+    struct pollfd pfd = { _progressFd[0], POLLIN, 0 };
+    ::poll(&pfd, 1, 100);
+    readProgressReports();
+    preemptStalledSlices();
+  }
+}
+
+/**
+ * Read all the UIHelper::ProgressReports which have arrived so far.
+ */
+void PortfolioMode::readProgressReports()
+{
+  UIHelper::ProgressReport report;
+  while(::read(_progressFd[0], &report, sizeof(report)) == sizeof(report)) {
+    SliceProgress* progress = _running.findPtr(report.pid);
+    if(!progress) {
+      // a snapshot worker we have not collected yet, the next report will do
+      continue;
+    }
+    if(!progress->lastProgressTime || report.activations > progress->activations) {
+      progress->lastProgressTime = Timer::elapsedMilliseconds();
+    }
+    progress->activations = report.activations;
+    progress->memoryKB = report.memoryKB;
+  }
+}
+
+/**
+ * Interrupt the slices which have not completed an activation within the stall limit.
+ *
+ * (A slice which has not reported yet, e.g. because it is still processing the input,
+ * or because it does not saturate at all, is never considered stalling.)
+ */
+void PortfolioMode::preemptStalledSlices()
+{
+  long now = Timer::elapsedMilliseconds();
+  decltype(_running)::Iterator it(_running);
+  while(it.hasNext()) {
+    pid_t process;
+    SliceProgress& progress = it.nextRef(process);
+    if(progress.preempted || !progress.lastProgressTime || now - progress.lastProgressTime < _stallLimit) {
+      continue;
+    }
+    if(outputAllowed()) {
+      addCommentSignForSZS(cout) << "Preempting " << progress.code << " stalled after "
+        << progress.activations << " activations using " << progress.memoryKB / 1024 << "MB" << endl;
+    }
+    progress.preempted = true;
+    Multiprocessing::instance()->killNoCheck(process, SIGINT);
+  }
+}
+
+/**
+ * Return @b sliceCode without its time limit and the value of its instruction limit,
+ * i.e. the part which stays the same when rescaleScheduleLimits() is applied.
+ */
+std::string PortfolioMode::sliceWithoutLimits(const std::string& sliceCode)
+{
+  std::string res = sliceCode.substr(0,sliceCode.find_last_of("_"));
+
+  size_t bidx = res.rfind(":i=");
+  if (bidx == std::string::npos) {
+    bidx = res.rfind("_i=");
+  }
+  if (bidx != std::string::npos) {
+    bidx += 3; // advance past the "[:_]i=" bit
+    size_t eidx = res.find_first_of(":_",bidx);
+    res.erase(bidx, eidx == std::string::npos ? std::string::npos : eidx-bidx);
+  }
+  return res;
+}
+
+/**
+ * Copy the slices of @b sOld, which has just been run, into @b sNew
+ * to be run again: first those which were making progress the fastest
+ * (as measured by activations per second), then those we know nothing about,
+ * leaving out those which got preempted for stalling.
+ */
+void PortfolioMode::prioritiseByProgress(const Schedule& sOld, Schedule& sNew)
+{
+  Stack<std::pair<float,std::string>> progressing;
+  Stack<std::string> unknown;
+
+  Schedule::BottomFirstIterator it(sOld);
+  while(it.hasNext()) {
+    std::string code = it.next();
+    float rate;
+    if(!_sliceRates.find(sliceWithoutLimits(code), rate)) {
+      unknown.push(code);
+    } else if(rate >= 0) {
+      progressing.push(std::make_pair(rate, code));
+    }
+  }
+  _sliceRates.reset();
+
+  if(progressing.isEmpty() && unknown.isEmpty()) {
+    // everything stalled, but the doubled limits may help after all
+    sNew.loadFromIterator(Schedule::BottomFirstIterator(sOld));
+    return;
+  }
+
+  std::stable_sort(progressing.begin(), progressing.end(),
+    [](const auto& a, const auto& b) { return a.first > b.first; });
+  for(const auto& p : progressing) {
+    sNew.push(p.second);
+  }
+  sNew.loadFromIterator(Stack<std::string>::BottomFirstIterator(unknown));
+}
+
 /**
  * Run a schedule.
  * Return true if a proof was found, otherwise return false.
@@ -575,10 +1084,14 @@ unsigned PortfolioMode::getSliceTime(const std::string &sliceCode)
 /**
  * Run a slice given by its code using the specified time limit.
  */
-void PortfolioMode::runSlice(std::string sliceCode, int timeLimitInDeciseconds)
+void PortfolioMode::runSlice(std::string sliceCode, int timeLimitInDeciseconds, bool preprocessed)
 {
   TIME_TRACE("run slice");
 
+  // the term bank and the rest of what we got from the parent stay shared with it for as long as we don't write to them
+  Lib::sealAllocations();
+  Kernel::Clause::sealAllocator();
+
   int sliceTime = getSliceTime(sliceCode);
   if (sliceTime > timeLimitInDeciseconds
     || !sliceTime) // no limit set, i.e. "infinity"
@@ -604,7 +1117,7 @@ void PortfolioMode::runSlice(std::string sliceCode, int timeLimitInDeciseconds)
     if (stl) {
       opt.setSimulatedTimeLimit(int(stl * _slowness));
     }
-    runSlice(opt);
+    runSlice(opt, preprocessed);
   }
   catch(Exception &e)
   {
@@ -619,11 +1132,17 @@ void PortfolioMode::runSlice(std::string sliceCode, int timeLimitInDeciseconds)
 
 /**
  * Run a slice given by its options
+ *
+ * If @b preprocessed is true, we have been forked by a snapshot process
+ * which has already preprocessed the problem as this slice would.
  */
-void PortfolioMode::runSlice(Options& opt)
+void PortfolioMode::runSlice(Options& opt, bool preprocessed)
 {
   System::registerForSIGHUPOnParentDeath();
   UIHelper::portfolioParent=false;
+  if (_stallLimit) {
+    UIHelper::progressReportFd = _progressFd[1];
+  }
 
   //we have already performed the normalization (or don't care about it)
   opt.setNormalize(false);
@@ -641,7 +1160,20 @@ void PortfolioMode::runSlice(Options& opt)
 
   Timer::reinitialise(Timer::instructionLimitingInPlace()); // timer only when done talking (otherwise output may get mangled)
 
-  Saturation::ProvingHelper::runVampire(*_prb, opt);
+  if (preprocessed) {
+    // what ProvingHelper::runVampirePreprocessing would have done (with our options) besides preprocessing
+    opt.resolveAwayAutoValues0();
+    if (!opt.randomizedPreprocessing()) { // otherwise the snapshot has used the same seed as us
+      if (opt.randomSeed() != 0) {
+        Lib::Random::setSeed(opt.randomSeed());
+      } else {
+        Lib::Random::resetSeed();
+      }
+    }
+    Saturation::ProvingHelper::runVampireSaturation(*_prb, opt);
+  } else {
+    Saturation::ProvingHelper::runVampire(*_prb, opt);
+  }
 
   bool succeeded =
     env.statistics->terminationReason == TerminationReason::REFUTATION ||
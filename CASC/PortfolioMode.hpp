@@ -15,11 +15,14 @@
 #ifndef __PortfolioMode__
 #define __PortfolioMode__
 
+#include <deque>
 #include <filesystem>
 
 #include "Forwards.hpp"
 
+#include "Lib/DHMap.hpp"
 #include "Lib/ScopedPtr.hpp"
+#include "Lib/Set.hpp"
 #include "Lib/Stack.hpp"
 
 #include "Kernel/Problem.hpp"
@@ -50,8 +53,56 @@ private:
 
   bool runSchedule(Schedule schedule);
   bool runScheduleAndRecoverProof(Schedule schedule);
-  [[noreturn]] void runSlice(std::string sliceCode, int remainingTime);
-  [[noreturn]] void runSlice(Options& strategyOpt);
+  pid_t forkSlice(std::string sliceCode, int remainingTime);
+  [[noreturn]] void runSlice(std::string sliceCode, int remainingTime, bool preprocessed = false);
+  [[noreturn]] void runSlice(Options& strategyOpt, bool preprocessed);
+
+  /**
+   * A process holding the problem preprocessed according to the options summarised by @b key
+   * (see Options::preprocessingKey()), which forks workers for the slices sharing these options.
+   *
+   * The workers get adopted by the portfolio process (as a child subreaper),
+   * so that they can be polled for in the same way as the directly forked ones.
+   */
+  struct PreprocessedSnapshot {
+    std::string key;
+    /** -1 once the process is gone */
+    pid_t pid;
+    /** slice codes (with deadlines) are sent here */
+    int requestFd;
+    /** pids of the forked workers come back here, in the order of the requests */
+    int replyFd;
+    /** requested slices, whose worker pids have not been read yet */
+    std::deque<std::string> pending;
+  };
+
+  bool requestFromSnapshot(const std::string& sliceCode, int remainingTime);
+  [[noreturn]] void runSnapshot(std::string sliceCode, int remainingTime, int requestFd, int replyFd);
+  unsigned pendingSnapshotWorkers();
+  void collectSnapshotWorkers(Set<pid_t>& processes);
+  void snapshotTerminated(pid_t snapshot, Set<pid_t>& processes);
+
+  /**
+   * What we know about a running slice (only tracked with --portfolio_stall_limit on)
+   */
+  struct SliceProgress {
+    std::string code;
+    /** when the slice was started */
+    long startTime;
+    /** when its number of activations last went up (0 if it has not reported yet) */
+    long lastProgressTime;
+    unsigned activations;
+    long memoryKB;
+    bool preempted;
+  };
+
+  void sliceStarted(pid_t process, const std::string& sliceCode, Set<pid_t>& processes);
+  void sliceTerminated(pid_t process);
+  pid_t waitForChild(bool& exited, bool& signalled, int& code);
+  void readProgressReports();
+  void preemptStalledSlices();
+  void prioritiseByProgress(const Schedule& sOld, Schedule& sNew);
+  static std::string sliceWithoutLimits(const std::string& sliceCode);
 
 #if VDEBUG
   DHSet<pid_t> childIds;
@@ -68,6 +119,22 @@ private:
    */
   ScopedPtr<Problem> _prb;
   float _slowness;
+
+  /** true if --portfolio_preprocessing_cache is on and supported here */
+  bool _preprocessingCache;
+  Stack<PreprocessedSnapshot> _snapshots;
+
+  /** --portfolio_stall_limit in milliseconds, 0 if we don't track progress */
+  long _stallLimit;
+  /** the (non-blocking) pipe through which the workers send their UIHelper::ProgressReports */
+  int _progressFd[2];
+  DHMap<pid_t, SliceProgress> _running;
+  /**
+   * Activations per second achieved by the slices of the current round of the schedule,
+   * negative for the slices which got preempted
+   * (keyed by sliceWithoutLimits(), as the limits get rescaled between the rounds)
+   */
+  DHMap<std::string, float> _sliceRates;
 };
 
 }
@@ -506,5 +506,87 @@ unsigned HashingClauseVariantIndex::computeHash(Literal* const * lits, unsigned
   return hash;
 }
 
+//-------------------//-------------------//-------------------//-------------------
+//-------------------//-------------------//-------------------//-------------------
+
+StoredClauseVariantIndex::~StoredClauseVariantIndex()
+{
+  DHMap<unsigned, ClauseStack*>::Iterator bit(_buckets);
+  while (bit.hasNext()) {
+    ClauseStack* bucket = bit.next();
+    for (Clause* cl : *bucket) {
+      cl->decRefCnt();
+    }
+    delete bucket;
+  }
+}
+
+void StoredClauseVariantIndex::insert(Clause* cl)
+{
+  ASS_NEQ(cl->store(), Clause::NONE);
+
+  ClauseStack** bucket;
+  if (_buckets.getValuePtr(cl->variantHash(), bucket)) {
+    *bucket = new ClauseStack();
+  }
+  cl->incRefCnt();
+  (*bucket)->push(cl);
+}
+
+/**
+ * Remove @b cl before it leaves its container, if it is there
+ */
+void StoredClauseVariantIndex::remove(Clause* cl)
+{
+  unsigned h = cl->variantHash();
+  ClauseStack* bucket;
+  if (!_buckets.find(h, bucket) || !bucket->remove(cl)) {
+    return;
+  }
+  if (bucket->isEmpty()) {
+    _buckets.remove(h);
+    delete bucket;
+  }
+  cl->decRefCnt();
+}
+
+ClauseIterator StoredClauseVariantIndex::retrieveVariants(Literal* const * lits, unsigned length)
+{
+  TIME_TRACE("stored clause variant retrieval");
+
+  unsigned h = Clause::variantHash(lits, length);
+  ClauseStack* bucket;
+  if (!_buckets.find(h, bucket)) {
+    return ClauseIterator::getEmpty();
+  }
+  removeUnstored(*bucket);
+  if (bucket->isEmpty()) {
+    _buckets.remove(h);
+    delete bucket;
+    return ClauseIterator::getEmpty();
+  }
+
+  return pvi( getFilteredIterator(
+      getMappingIterator(
+        ClauseStack::Iterator(*bucket),
+        ResultClauseToVariantClauseFn(lits, length)),
+      NonzeroFn()) );
+}
+
+/**
+ * Remove from @b bucket (and release) the clauses that are no longer stored in a container
+ */
+void StoredClauseVariantIndex::removeUnstored(ClauseStack& bucket)
+{
+  unsigned kept = 0;
+  for (Clause* cl : bucket) {
+    if (cl->store() == Clause::NONE) {
+      cl->decRefCnt();
+    } else {
+      bucket[kept++] = cl;
+    }
+  }
+  bucket.truncate(kept);
+}
 
 }
@@ -112,6 +112,34 @@ private:
   DHMap<unsigned, ClauseList*> _entries;
 };
 
+/**
+ * Variant index of the clauses kept by the saturation algorithm,
+ * hashed by Clause::variantHash().
+ *
+ * A clause belongs to the index only while it is stored in one of the clause
+ * containers. The index holds a reference to each of its clauses, which the
+ * saturation algorithm removes as they leave the containers for good. Should
+ * a clause get to Clause::NONE some other way, it is dropped when its bucket
+ * is retrieved.
+ */
+class StoredClauseVariantIndex : public ClauseVariantIndex
+{
+public:
+  virtual ~StoredClauseVariantIndex() override;
+
+  /** Insert @b cl, which must be stored in a container */
+  virtual void insert(Clause* cl) override;
+  void remove(Clause* cl);
+
+  using ClauseVariantIndex::retrieveVariants;
+  ClauseIterator retrieveVariants(Literal* const * lits, unsigned length) override;
+
+private:
+  static void removeUnstored(ClauseStack& bucket);
+
+  DHMap<unsigned, ClauseStack*> _buckets;
+};
+
 };
 
 #endif /* __ClauseVariantIndex__ */
@@ -101,7 +101,7 @@ CodeTree::MatchInfo* CodeTree::MatchInfo::alloc(unsigned bindCnt)
   size_t size=sizeof(MatchInfo)+bindCnt*sizeof(TermList);
   size-=sizeof(TermList);
 
-  void* mem=ALLOC_KNOWN(size,"CodeTree::MatchInfo");
+  void* mem=ALLOC_KNOWN(size,"Indexing::CodeTree::MatchInfo");
   return reinterpret_cast<MatchInfo*>(mem);
 }
 
@@ -116,7 +116,7 @@ void CodeTree::MatchInfo::destroy(unsigned bindCnt)
   size_t size=sizeof(MatchInfo)+bindCnt*sizeof(TermList);
   size-=sizeof(TermList);
 
-  DEALLOC_KNOWN(this, size,"CodeTree::MatchInfo");
+  DEALLOC_KNOWN(this, size,"Indexing::CodeTree::MatchInfo");
 }
 
 
@@ -141,7 +141,7 @@ CodeTree::ILStruct::ILStruct(const Literal* lit, unsigned varCnt, Stack<unsigned
   if(varCnt) {
     size_t gvnSize=sizeof(unsigned)*varCnt;
     globalVarNumbers=static_cast<unsigned*>(
-	ALLOC_KNOWN(gvnSize, "CodeTree::ILStruct::globalVarNumbers"));
+	ALLOC_KNOWN(gvnSize, "Indexing::CodeTree::ILStruct"));
     memcpy(globalVarNumbers, gvnStack.begin(), gvnSize);
   }
   else {
@@ -165,14 +165,14 @@ CodeTree::ILStruct::~ILStruct()
   if(globalVarNumbers) {
     size_t gvSize=sizeof(unsigned)*varCnt;
     DEALLOC_KNOWN(globalVarNumbers, gvSize,
-		"CodeTree::ILStruct::globalVarNumbers");
+		"Indexing::CodeTree::ILStruct");
     if(sortedGlobalVarNumbers) {
       DEALLOC_KNOWN(sortedGlobalVarNumbers, gvSize,
-		  "CodeTree::ILStruct::sortedGlobalVarNumbers");
+		  "Indexing::CodeTree::ILStruct");
     }
     if(globalVarPermutation) {
       DEALLOC_KNOWN(globalVarPermutation, gvSize,
-		  "CodeTree::ILStruct::globalVarPermutation");
+		  "Indexing::CodeTree::ILStruct");
     }
   }
 }
@@ -211,9 +211,9 @@ void CodeTree::ILStruct::putIntoSequence(ILStruct* previous_)
 
   size_t gvSize=sizeof(unsigned)*varCnt;
   sortedGlobalVarNumbers=static_cast<unsigned*>(
-	ALLOC_KNOWN(gvSize, "CodeTree::ILStruct::sortedGlobalVarNumbers"));
+	ALLOC_KNOWN(gvSize, "Indexing::CodeTree::ILStruct"));
   globalVarPermutation=static_cast<unsigned*>(
-	ALLOC_KNOWN(gvSize, "CodeTree::ILStruct::globalVarPermutation"));
+	ALLOC_KNOWN(gvSize, "Indexing::CodeTree::ILStruct"));
 
   for(unsigned i=0;i<varCnt;i++) {
     sortedGlobalVarNumbers[i]=gvArr[i].first;
@@ -1375,66 +1375,99 @@ bool CodeTree::Matcher::execute()
     }
   }
 
+  //Each handler below ends by jumping directly to the handler of the next
+  //operation. With the GCC "labels as values" extension, this is an indirect
+  //jump through a table indexed by the instruction, so every handler has its
+  //own dispatch branch which the processor can predict separately, rather than
+  //all operations going through the single branch of a switch in a loop.
+#ifdef __GNUC__
+  static void* const handlers[8] = {
+    &&success_or_fail, &&check_ground_term, &&lit_end, &&check_fun,
+    &&assign_var, &&check_var, &&search_struct, &&invalid
+  };
+#define CODE_TREE_JUMP goto *handlers[op->_instruction()]
+#else
+#define CODE_TREE_JUMP \
+  switch(op->_instruction()) { \
+    case SUCCESS_OR_FAIL: goto success_or_fail; \
+    case CHECK_GROUND_TERM: goto check_ground_term; \
+    case LIT_END: goto lit_end; \
+    case CHECK_FUN: goto check_fun; \
+    case ASSIGN_VAR: goto assign_var; \
+    case CHECK_VAR: goto check_var; \
+    case SEARCH_STRUCT: goto search_struct; \
+    default: goto invalid; \
+  }
+#endif
+  //record the alternative of the current operation and execute it
+#define CODE_TREE_DISPATCH \
+  if(op->alternative()) { \
+    btStack.push(BTPoint(tp, op->alternative())); \
+  } \
+  CODE_TREE_JUMP
+  //In each CodeBlock there is always either operation LIT_END or FAIL,
+  //so after an operation that is neither, we may safely increase the
+  //operation pointer (the SEARCH_STRUCT operation does not appear in
+  //CodeBlocks)
+#define CODE_TREE_NEXT \
+  ASS(!op->isSearchStruct()); \
+  op++; \
+  CODE_TREE_DISPATCH
+#define CODE_TREE_BACKTRACK \
+  if(!backtrack()) { \
+    return false; \
+  } \
+  CODE_TREE_DISPATCH
+
+  CODE_TREE_DISPATCH;
+
+success_or_fail:
+  //yield successes only in the first round (we don't want to yield the
+  //same thing for each query literal)
+  if(op->isFail() || curLInfo!=0) {
+    CODE_TREE_BACKTRACK;
+  }
+  return true;
 
-  bool shouldBacktrack=false;
-  for(;;) {
-    if(op->alternative()) {
-      btStack.push(BTPoint(tp, op->alternative()));
-    }
-    switch(op->_instruction()) {
-      case SUCCESS_OR_FAIL:
-        if(op->isFail()) {
-          shouldBacktrack=true;
-          break;
-        }
-        //yield successes only in the first round (we don't want to yield the
-        //same thing for each query literal)
-        if(curLInfo==0) {
-          return true;
-        }
-        else {
-          shouldBacktrack=true;
-        }
-        break;
-      case LIT_END:
-        return true;
-      case CHECK_GROUND_TERM:
-        shouldBacktrack=!doCheckGroundTerm();
-        break;
-      case CHECK_FUN:
-        shouldBacktrack=!doCheckFun();
-        break;
-      case ASSIGN_VAR:
-        doAssignVar();
-        break;
-      case CHECK_VAR:
-        shouldBacktrack=!doCheckVar();
-        break;
-      case SEARCH_STRUCT:
-        if(doSearchStruct()) {
-          //a new value of @b op is assigned, so restart the loop
-          continue;
-        }
-        else {
-          shouldBacktrack=true;
-        }
-        break;
-    }
-    if(shouldBacktrack) {
-      if(!backtrack()) {
-	return false;
-      }
-      shouldBacktrack=false;
-    }
-    else {
-      //the SEARCH_STRUCT operation does not appear in CodeBlocks
-      ASS(!op->isSearchStruct());
-      //In each CodeBlock there is always either operation LIT_END or FAIL.
-      //As we haven't encountered one yet, we may safely increase the
-      //operation pointer
-      op++;
-    }
+lit_end:
+  return true;
+
+check_ground_term:
+  if(!doCheckGroundTerm()) {
+    CODE_TREE_BACKTRACK;
+  }
+  CODE_TREE_NEXT;
+
+check_fun:
+  if(!doCheckFun()) {
+    CODE_TREE_BACKTRACK;
+  }
+  CODE_TREE_NEXT;
+
+assign_var:
+  doAssignVar();
+  CODE_TREE_NEXT;
+
+check_var:
+  if(!doCheckVar()) {
+    CODE_TREE_BACKTRACK;
   }
+  CODE_TREE_NEXT;
+
+search_struct:
+  //a new value of @b op is assigned, so we dispatch on it
+  if(!doSearchStruct()) {
+    CODE_TREE_BACKTRACK;
+  }
+  CODE_TREE_DISPATCH;
+
+invalid:
+  ASSERTION_VIOLATION;
+
+#undef CODE_TREE_BACKTRACK
+#undef CODE_TREE_NEXT
+#undef CODE_TREE_DISPATCH
+#undef CODE_TREE_JUMP
 }
 
 /**
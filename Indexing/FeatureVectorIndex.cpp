@@ -0,0 +1,146 @@
+/*
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ */
+/**
+ * @file FeatureVectorIndex.cpp
+ * Implements classes FeatureVector, FeatureVectorIndex and FwSubsFeatureVectorIndex.
+ */
+
+#include "Debug/TimeProfiling.hpp"
+
+#include "Kernel/Clause.hpp"
+#include "Kernel/Term.hpp"
+#include "Kernel/TermIterators.hpp"
+
+#include "FeatureVectorIndex.hpp"
+
+namespace Indexing {
+
+FeatureVector::FeatureVector(Clause* cl)
+{
+  unsigned functionCounts[SYMBOL_BUCKETS];
+  for (Literal* lit : cl->iterLits()) {
+    bool positive = lit->isPositive();
+    unsigned pred = bucket(lit->functor());
+    add(positive ? POSITIVE_LITERALS : NEGATIVE_LITERALS, 1);
+    add((positive ? POSITIVE_PREDICATES : NEGATIVE_PREDICATES) + pred, 1);
+    max(LITERAL_PREDICATES + pred, 1);
+
+    std::fill(functionCounts, functionCounts + SYMBOL_BUCKETS, 0);
+    unsigned symbols = 1;
+    NonVariableIterator sit(lit);
+    while (sit.hasNext()) {
+      functionCounts[bucket(sit.next().term()->functor())]++;
+      symbols++;
+    }
+    for (unsigned b = 0; b < SYMBOL_BUCKETS; b++) {
+      add((positive ? POSITIVE_FUNCTIONS : NEGATIVE_FUNCTIONS) + b, functionCounts[b]);
+      max(LITERAL_FUNCTIONS + b, functionCounts[b]);
+    }
+    max(LITERAL_SYMBOLS, symbols);
+  }
+}
+
+void FeatureVectorIndex::handleClause(Clause* c, bool adding)
+{
+  TIME_TRACE("feature vector index maintenance");
+
+  if (adding) {
+    _vectors.insert(c, FeatureVector(c));
+  } else {
+    _vectors.remove(c);
+  }
+}
+
+FwSubsFeatureVectorIndex::FwSubsFeatureVectorIndex(Stack<unsigned> levels)
+  : _levels(std::move(levels))
+{
+  ASS(iterTraits(_levels.iter()).all([](unsigned f) { return f < FeatureVector::FEATURES; }))
+}
+
+FwSubsFeatureVectorIndex::~FwSubsFeatureVectorIndex()
+{
+  for (auto& [value, child] : iterTraits(_root.children.iter())) {
+    destroy(child);
+  }
+}
+
+void FwSubsFeatureVectorIndex::destroy(Node* node)
+{
+  for (auto& [value, child] : iterTraits(node->children.iter())) {
+    destroy(child);
+  }
+  delete node;
+}
+
+void FwSubsFeatureVectorIndex::insert(Clause* cl, const FeatureVector& vector)
+{
+  Node* node = &_root;
+  for (unsigned feature : _levels) {
+    unsigned value = vector[feature];
+    auto pos = findChild(node, value);
+    if (pos == node->children.end() || pos->first != value) {
+      // keep the children sorted: push the new child and rotate it into its place
+      unsigned index = pos - node->children.begin();
+      node->children.push(std::make_pair(value, new Node()));
+      pos = node->children.begin() + index;
+      std::rotate(pos, node->children.end() - 1, node->children.end());
+    }
+    node = pos->second;
+  }
+  node->entries.push(std::make_pair(cl, vector));
+}
+
+void FwSubsFeatureVectorIndex::remove(Clause* cl, const FeatureVector& vector)
+{
+  // the nodes on the path to the leaf, each with the index of the child taken from it
+  static Stack<std::pair<Node*, unsigned>> path;
+  path.reset();
+
+  Node* node = &_root;
+  for (unsigned feature : _levels) {
+    auto pos = findChild(node, vector[feature]);
+    ASS(pos != node->children.end() && pos->first == vector[feature])
+    path.push(std::make_pair(node, pos - node->children.begin()));
+    node = pos->second;
+  }
+
+  auto& entries = node->entries;
+  unsigned i = 0;
+  while (entries[i].first != cl) {
+    i++;
+    ASS_L(i, entries.size())
+  }
+  entries[i] = entries.top();
+  entries.pop();
+
+  // remove the nodes that became empty
+  while (node->entries.isEmpty() && node->children.isEmpty() && path.isNonEmpty()) {
+    auto [parent, index] = path.pop();
+    delete node;
+    // keep the children sorted
+    std::rotate(parent->children.begin() + index, parent->children.begin() + index + 1, parent->children.end());
+    parent->children.pop();
+    node = parent;
+  }
+}
+
+void FwSubsFeatureVectorIndex::handleClause(Clause* c, bool adding)
+{
+  TIME_TRACE("forward subsumption index maintenance");
+
+  FeatureVector vector(c);
+  if (adding) {
+    insert(c, vector);
+  } else {
+    remove(c, vector);
+  }
+}
+
+} // namespace Indexing
@@ -13,6 +13,9 @@
  *
  */
 
+#include "Lib/Environment.hpp"
+#include "Shell/Options.hpp"
+
 #include "Index.hpp"
 #include "Forwards.hpp"
 
@@ -24,6 +27,11 @@ using namespace Lib;
 using namespace Kernel;
 using namespace Saturation;
 
+Index::Index()
+  : _measured(env.options->indexStatistics())
+{
+}
+
 Index::~Index()
 {
   if(!_addedSD.isEmpty()) {
@@ -46,4 +54,15 @@ void Index::attachContainer(ClauseContainer* cc)
   _removedSD = cc->removedEvent.subscribe(this,&Index::onRemovedFromContainer);
 }
 
+void IndexStatistics::add(const IndexStatistics& other)
+{
+  additions += other.additions;
+  removals += other.removals;
+  queries += other.queries;
+  results += other.results;
+  accepted += other.accepted;
+  maintenanceTime += other.maintenanceTime;
+  retrievalTime += other.retrievalTime;
+}
+
 }
@@ -15,6 +15,8 @@
 #ifndef __Indexing_Index__
 #define __Indexing_Index__
 
+#include <chrono>
+
 #include "Forwards.hpp"
 #include "Lib/Output.hpp"
 
@@ -185,27 +187,146 @@ template<class Unifier, class Data>
 QueryRes<Unifier, Data> queryRes(Unifier unifier, Data const* d) 
 { return QueryRes<Unifier, Data>(std::move(unifier), std::move(d)); }
 
+/**
+ * Counters of the work done by an index, collected with the index_statistics option
+ */
+struct IndexStatistics
+{
+  /** number of clauses added to and removed from the index */
+  unsigned long additions = 0;
+  unsigned long removals = 0;
+  /** number of retrieval queries, of the results they returned, and of those the inferences used */
+  unsigned long queries = 0;
+  unsigned long results = 0;
+  unsigned long accepted = 0;
+  /** time spent maintaining the index and retrieving from it, in nanoseconds */
+  unsigned long long maintenanceTime = 0;
+  unsigned long long retrievalTime = 0;
+
+  void add(const IndexStatistics& other);
+
+  /** Adds the time from its construction to its destruction to a counter */
+  class Stopwatch
+  {
+  public:
+    explicit Stopwatch(unsigned long long& counter)
+      : _counter(counter), _start(std::chrono::steady_clock::now()) {}
+    ~Stopwatch()
+    { _counter += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - _start).count(); }
+  private:
+    unsigned long long& _counter;
+    std::chrono::steady_clock::time_point _start;
+  };
+};
+
+/**
+ * The shape of an indexing structure: the numbers of its nodes of each kind
+ * and the depth of its entries
+ */
+struct IndexShape
+{
+  /** intermediate nodes by their SubstitutionTree::NodeAlgorithm */
+  unsigned long nodes[5] = {};
+  unsigned long leaves = 0;
+  unsigned long entries = 0;
+  /** the sum of the depths of the leaves of all the entries */
+  unsigned long depthSum = 0;
+};
+
+/**
+ * Iterator over the results of a query that adds them
+ * and the time spent in it to IndexStatistics
+ */
+template<class Inner>
+class MeasuredIterator
+{
+public:
+  DECL_ELEMENT_TYPE(ELEMENT_TYPE(Inner));
+
+  MeasuredIterator(Inner inner, IndexStatistics& statistics)
+    : _inner(std::move(inner)), _statistics(statistics) {}
+
+  bool hasNext()
+  {
+    IndexStatistics::Stopwatch sw(_statistics.retrievalTime);
+    return _inner.hasNext();
+  }
+
+  OWN_ELEMENT_TYPE next()
+  {
+    IndexStatistics::Stopwatch sw(_statistics.retrievalTime);
+    _statistics.results++;
+    return _inner.next();
+  }
+
+private:
+  Inner _inner;
+  IndexStatistics& _statistics;
+};
+
 class Index
 {
 public:
   virtual ~Index();
 
   void attachContainer(ClauseContainer* cc);
+
+  const IndexStatistics& statistics() const { return _statistics; }
+  /** Record that an inference used a result retrieved from the index */
+  void recordAccepted() { _statistics.accepted++; }
+  /** Add the nodes of the indexing structure to @b shape, if its kind has nodes */
+  virtual void collectShape(IndexShape& shape) {}
+
 protected:
-  Index() {}
+  Index();
 
   void onAddedToContainer(Clause* c)
-  { handleClause(c, true); }
+  {
+    if (_measured) {
+      _statistics.additions++;
+      IndexStatistics::Stopwatch sw(_statistics.maintenanceTime);
+      handleClause(c, true);
+    } else {
+      handleClause(c, true);
+    }
+  }
   void onRemovedFromContainer(Clause* c)
-  { handleClause(c, false); }
+  {
+    if (_measured) {
+      _statistics.removals++;
+      IndexStatistics::Stopwatch sw(_statistics.maintenanceTime);
+      handleClause(c, false);
+    } else {
+      handleClause(c, false);
+    }
+  }
 
   virtual void handleClause(Clause* c, bool adding) {}
 
+  /**
+   * Return the results of the query @b query() and count the query,
+   * its results and the time spent in it, if the index is being measured.
+   */
+  template<class Query>
+  auto measured(Query query) -> decltype(query())
+  {
+    if (!_measured) {
+      return query();
+    }
+    _statistics.queries++;
+    IndexStatistics::Stopwatch sw(_statistics.retrievalTime);
+    return pvi(MeasuredIterator<decltype(query())>(query(), _statistics));
+  }
+
   //TODO: postponing index modifications during iteration (methods isBeingIterated() etc...)
 
 private:
   SubscriptionData _addedSD;
   SubscriptionData _removedSD;
+
+  /** are the statistics collected (see the index_statistics option) */
+  bool _measured;
+  IndexStatistics _statistics;
 };
 
 };
@@ -22,6 +22,7 @@
 #include "AcyclicityIndex.hpp"
 #include "Kernel/OrderingUtils.hpp"
 #include "CodeTreeInterfaces.hpp"
+#include "FeatureVectorIndex.hpp"
 #include "LiteralIndex.hpp"
 #include "LiteralSubstitutionTree.hpp"
 #include "TermIndex.hpp"
@@ -66,6 +67,9 @@ void IndexManager::release(IndexType t)
 
   e.refCnt--;
   if(e.refCnt==0) {
+    IndexStatistics* released;
+    _releasedStatistics.getValuePtr(t, released);
+    released->add(e.index->statistics());
     delete e.index;
     _store.remove(t);
   } else {
@@ -110,6 +114,8 @@ Index* IndexManager::create(IndexType t)
   Index* res;
   using TermSubstitutionTree    = Indexing::TermSubstitutionTree<TermLiteralClause>;
   using LiteralSubstitutionTree = Indexing::LiteralSubstitutionTree<LiteralClause>;
+  // the subterm indices get the most entries, so their large nodes are kept as sorted arrays for faster lookup by top symbol
+  auto subtermTree = []() { return new TermSubstitutionTree(Indexing::SubstitutionTree<TermLiteralClause>::SORTED_ARRAY); };
 
   bool isGenerating;
   switch(t) {
@@ -121,6 +127,10 @@ Index* IndexManager::create(IndexType t)
     res = new BackwardSubsumptionIndex(new LiteralSubstitutionTree());
     isGenerating = false;
     break;
+  case BACKWARD_SUBSUMPTION_FEATURE_VECTORS:
+    res = new FeatureVectorIndex();
+    isGenerating = false;
+    break;
   case FW_SUBSUMPTION_UNIT_CLAUSE_SUBST_TREE:
     res = new UnitClauseLiteralIndex(new LiteralSubstitutionTree());
     isGenerating = false;
@@ -193,7 +203,7 @@ Index* IndexManager::create(IndexType t)
     break;
 
   case SUPERPOSITION_SUBTERM_SUBST_TREE:
-    res = new SuperpositionSubtermIndex(new TermSubstitutionTree(), _alg->getOrdering());
+    res = new SuperpositionSubtermIndex(subtermTree(), _alg->getOrdering());
     isGenerating = true;
     break;
 
@@ -234,9 +244,9 @@ Index* IndexManager::create(IndexType t)
 
   case DEMODULATION_SUBTERM_SUBST_TREE:
     if (env.options->combinatorySup()) {
-      res = new DemodulationSubtermIndexImpl<true>(new TermSubstitutionTree(),_alg->getOptions());
+      res = new DemodulationSubtermIndexImpl<true>(subtermTree(),_alg->getOptions());
     } else {
-      res = new DemodulationSubtermIndexImpl<false>(new TermSubstitutionTree(),_alg->getOptions());
+      res = new DemodulationSubtermIndexImpl<false>(subtermTree(),_alg->getOptions());
     }
     isGenerating = false;
     break;
@@ -255,6 +265,25 @@ Index* IndexManager::create(IndexType t)
     isGenerating = false;
     break;
 
+  case FW_SUBSUMPTION_FEATURE_VECTORS: {
+    Stack<unsigned> levels = {
+      FeatureVector::POSITIVE_LITERALS,
+      FeatureVector::NEGATIVE_LITERALS,
+      FeatureVector::LITERAL_SYMBOLS,
+    };
+    if (_alg->getOptions().featureVectorSubsumption() == Options::FeatureVectorSubsumption::SYMBOLS) {
+      // every level makes each query visit more nodes, so only branch on whether the clause has
+      // a predicate of the first few buckets, which prunes for subsumption resolution as well,
+      // and leave the other symbol features to the leaves
+      for (unsigned b = 0; b < FwSubsFeatureVectorIndex::SYMBOL_LEVELS; b++) {
+        levels.push(FeatureVector::LITERAL_PREDICATES + b);
+      }
+    }
+    res = new FwSubsFeatureVectorIndex(std::move(levels));
+    isGenerating = false;
+    break;
+  }
+
   case FSD_SUBST_TREE:
     res = new FSDLiteralIndex(new LiteralSubstitutionTree());
     isGenerating = false;
@@ -291,3 +320,100 @@ Index* IndexManager::create(IndexType t)
   }
   return res;
 }
+
+void IndexManager::printStatistics(std::ostream& out)
+{
+  auto printTime = [&](unsigned long long nanoseconds) {
+    out << (nanoseconds / 1000) / 1000.0 << " ms";
+  };
+
+  out << "Index statistics after " << env.statistics->activations << " activations" << std::endl;
+  for (unsigned i = BINARY_RESOLUTION_SUBST_TREE; i <= STRUCT_INDUCTION_TERM_INDEX; i++) {
+    IndexType t = static_cast<IndexType>(i);
+    Entry* e = _store.findPtr(t);
+    IndexStatistics* released = _releasedStatistics.findPtr(t);
+    if (!e && !released) {
+      continue;
+    }
+    IndexStatistics stats;
+    if (e) {
+      stats.add(e->index->statistics());
+    }
+    if (released) {
+      stats.add(*released);
+    }
+
+    out << indexTypeName(t) << ": " << (e ? "" : "released, ")
+        << stats.additions - stats.removals << " clauses (" << stats.additions << " added, " << stats.removals << " removed), "
+        << stats.queries << " queries, " << stats.results << " results";
+    if (stats.accepted) {
+      out << " (" << stats.accepted << " used)";
+    }
+    out << ", retrieval ";
+    printTime(stats.retrievalTime);
+    out << ", maintenance ";
+    printTime(stats.maintenanceTime);
+    out << std::endl;
+
+    if (!e) {
+      continue;
+    }
+    IndexShape shape;
+    e->index->collectShape(shape);
+    if (shape.leaves) {
+      // by SubstitutionTree::NodeAlgorithm
+      static const char* algorithms[] = { nullptr, "unsorted list", "skip list", "set", "sorted array" };
+      out << "  nodes:";
+      for (unsigned a = 1; a < 5; a++) {
+        out << " " << shape.nodes[a] << " " << algorithms[a] << ",";
+      }
+      out << " " << shape.leaves << " leaves with " << shape.entries << " entries, average depth "
+          << (shape.entries ? (double)shape.depthSum / shape.entries : 0.0) << std::endl;
+    }
+  }
+}
+
+const char* IndexManager::indexTypeName(IndexType t)
+{
+  switch(t) {
+  case BINARY_RESOLUTION_SUBST_TREE: return "binary resolution";
+  case BACKWARD_SUBSUMPTION_SUBST_TREE: return "backward subsumption";
+  case BACKWARD_SUBSUMPTION_FEATURE_VECTORS: return "backward subsumption feature vectors";
+  case FW_SUBSUMPTION_UNIT_CLAUSE_SUBST_TREE: return "forward subsumption unit clauses";
+  case URR_UNIT_CLAUSE_SUBST_TREE: return "UR resolution unit clauses";
+  case URR_UNIT_CLAUSE_WITH_AL_SUBST_TREE: return "UR resolution unit clauses with answer literals";
+  case URR_NON_UNIT_CLAUSE_SUBST_TREE: return "UR resolution non-unit clauses";
+  case URR_NON_UNIT_CLAUSE_WITH_AL_SUBST_TREE: return "UR resolution non-unit clauses with answer literals";
+  case SUPERPOSITION_SUBTERM_SUBST_TREE: return "superposition subterms";
+  case SUPERPOSITION_LHS_SUBST_TREE: return "superposition left-hand sides";
+  case SUB_VAR_SUP_SUBTERM_SUBST_TREE: return "subterm variable superposition subterms";
+  case SUB_VAR_SUP_LHS_SUBST_TREE: return "subterm variable superposition left-hand sides";
+  case ALASCA_FOURIER_MOTZKIN_LHS_SUBST_TREE: return "ALASCA Fourier-Motzkin left-hand sides";
+  case ALASCA_FOURIER_MOTZKIN_RHS_SUBST_TREE: return "ALASCA Fourier-Motzkin right-hand sides";
+  case ALASCA_BINARY_RESOLUTION_LHS_SUBST_TREE: return "ALASCA binary resolution left-hand sides";
+  case ALASCA_BINARY_RESOLUTION_RHS_SUBST_TREE: return "ALASCA binary resolution right-hand sides";
+  case ALASCA_SUPERPOSITION_LHS_SUBST_TREE: return "ALASCA superposition left-hand sides";
+  case ALASCA_SUPERPOSITION_RHS_SUBST_TREE: return "ALASCA superposition right-hand sides";
+  case ALASCA_COHERENCE_RHS_SUBST_TREE: return "ALASCA coherence right-hand sides";
+  case ALASCA_COHERENCE_LHS_SUBST_TREE: return "ALASCA coherence left-hand sides";
+  case ALASCA_FWD_DEMODULATION_SUBST_TREE: return "ALASCA forward demodulation";
+  case ALASCA_BWD_DEMODULATION_SUBST_TREE: return "ALASCA backward demodulation";
+  case DEMODULATION_SUBTERM_SUBST_TREE: return "demodulation subterms";
+  case DEMODULATION_LHS_CODE_TREE: return "demodulation left-hand sides (code tree)";
+  case FW_SUBSUMPTION_CODE_TREE: return "forward subsumption (code tree)";
+  case FW_SUBSUMPTION_SUBST_TREE: return "forward subsumption";
+  case FW_SUBSUMPTION_FEATURE_VECTORS: return "forward subsumption feature vectors";
+  case BW_SUBSUMPTION_SUBST_TREE: return "backward subsumption literals";
+  case FSD_SUBST_TREE: return "forward subsumption demodulation";
+  case REWRITE_RULE_SUBST_TREE: return "rewrite rules";
+  case ACYCLICITY_INDEX: return "acyclicity";
+  case NARROWING_INDEX: return "narrowing";
+  case PRIMITIVE_INSTANTIATION_INDEX: return "primitive instantiation";
+  case SKOLEMISING_FORMULA_INDEX: return "skolemising formulas";
+  case RENAMING_FORMULA_INDEX: return "renaming formulas";
+  case UNIT_INT_COMPARISON_INDEX: return "unit integer comparisons";
+  case INDUCTION_TERM_INDEX: return "induction terms";
+  case STRUCT_INDUCTION_TERM_INDEX: return "structural induction terms";
+  }
+  ASSERTION_VIOLATION;
+}
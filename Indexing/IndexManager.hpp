@@ -33,6 +33,7 @@ using namespace Saturation;
 enum IndexType {
   BINARY_RESOLUTION_SUBST_TREE=1,
   BACKWARD_SUBSUMPTION_SUBST_TREE,
+  BACKWARD_SUBSUMPTION_FEATURE_VECTORS,
   FW_SUBSUMPTION_UNIT_CLAUSE_SUBST_TREE,
 
   URR_UNIT_CLAUSE_SUBST_TREE,
@@ -60,6 +61,7 @@ enum IndexType {
 
   FW_SUBSUMPTION_CODE_TREE,
   FW_SUBSUMPTION_SUBST_TREE,
+  FW_SUBSUMPTION_FEATURE_VECTORS,
   BW_SUBSUMPTION_SUBST_TREE,
 
   FSD_SUBST_TREE,
@@ -94,6 +96,10 @@ public:
   Index* get(IndexType t);
 
   void provideIndex(IndexType t, Index* index);
+
+  /** Print the statistics of the indexes collected with the index_statistics option */
+  void printStatistics(std::ostream& out);
+  static const char* indexTypeName(IndexType t);
 private:
 
   struct Entry {
@@ -102,6 +108,8 @@ private:
   };
   SaturationAlgorithm* _alg;
   DHMap<IndexType,Entry> _store;
+  /** the statistics of the indexes already released */
+  DHMap<IndexType,IndexStatistics> _releasedStatistics;
 
   Index* create(IndexType t);
   Shell::Options::UnificationWithAbstraction _uwa;
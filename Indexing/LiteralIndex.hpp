@@ -34,16 +34,19 @@ public:
   { return _is->getAll(); }
 
   VirtualIterator<QueryRes<ResultSubstitutionSP, LiteralClause>> getUnifications(Literal* lit, bool complementary, bool retrieveSubstitutions = true)
-  { return _is->getUnifications(lit, complementary, retrieveSubstitutions); }
+  { return measured([&]() { return _is->getUnifications(lit, complementary, retrieveSubstitutions); }); }
 
   VirtualIterator<QueryRes<AbstractingUnifier*, Data>> getUwa(Literal* lit, bool complementary, Options::UnificationWithAbstraction uwa, bool fixedPointIteration)
-  { return _is->getUwa(lit, complementary, uwa, fixedPointIteration); }
+  { return measured([&]() { return _is->getUwa(lit, complementary, uwa, fixedPointIteration); }); }
 
   VirtualIterator<QueryRes<ResultSubstitutionSP, LiteralClause>> getGeneralizations(Literal* lit, bool complementary, bool retrieveSubstitutions = true)
-  { return _is->getGeneralizations(lit, complementary, retrieveSubstitutions); }
+  { return measured([&]() { return _is->getGeneralizations(lit, complementary, retrieveSubstitutions); }); }
 
   VirtualIterator<QueryRes<ResultSubstitutionSP, LiteralClause>> getInstances(Literal* lit, bool complementary, bool retrieveSubstitutions = true)
-  { return _is->getInstances(lit, complementary, retrieveSubstitutions); }
+  { return measured([&]() { return _is->getInstances(lit, complementary, retrieveSubstitutions); }); }
+
+  void collectShape(IndexShape& shape) override
+  { _is->collectShape(shape); }
 
   size_t getUnificationCount(Literal* lit, bool complementary)
   { return _is->getUnificationCount(lit, complementary); }
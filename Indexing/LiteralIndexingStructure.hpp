@@ -46,6 +46,9 @@ public:
     return countIteratorElements(getUnifications(lit, complementary, false));
   }
 
+  /** Add the nodes of the structure to @b shape, if it has nodes */
+  virtual void collectShape(IndexShape& shape) {}
+
   virtual void output(std::ostream& out, Option<unsigned> multilineIndent) const = 0;
 
   friend std::ostream& operator<<(std::ostream& out,                 LiteralIndexingStructure const& self) {      self.output(out, {}               ); return out; }
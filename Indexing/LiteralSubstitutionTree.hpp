@@ -151,6 +151,13 @@ public:
     }
   }
 
+  void collectShape(IndexShape& shape) final override
+  {
+    for (auto& t : _trees) {
+      t->collectShape(shape);
+    }
+  }
+
 
 private:
   SubstitutionTree& getTree(Literal* lit, bool complementary)
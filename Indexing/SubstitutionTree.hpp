@@ -21,6 +21,8 @@
 #define DEBUG_INSERT(lvl, ...) if (lvl < 0) DBG(__VA_ARGS__)
 #define DEBUG_REMOVE(lvl, ...) if (lvl < 0) DBG(__VA_ARGS__)
 
+#include <climits>
+#include <cstdint>
 #include <utility>
 
 #include "Forwards.hpp"
@@ -40,6 +42,7 @@
 #include "Lib/ArrayMap.hpp"
 #include "Lib/Array.hpp"
 #include "Lib/BiMap.hpp"
+#include "Lib/DHMap.hpp"
 #include "Kernel/ApplicativeHelper.hpp"
 #include "Lib/Recycled.hpp"
 
@@ -179,6 +182,7 @@ public:
   static void swap(SubstitutionTree& self, SubstitutionTree& other) {
     std::swap(self._nextVar, other._nextVar);
     std::swap(self._root,    other._root);
+    std::swap(self._largeNodeAlgorithm, other._largeNodeAlgorithm);
   }
   SubstitutionTree& operator=(SubstitutionTree && other) { swap(*this,other); return *this; }
   SubstitutionTree(SubstitutionTree&& other) : SubstitutionTree() { swap(*this, other); }
@@ -232,6 +236,13 @@ public:
                      : pvi(iterPointer(Recycled<I>(this, _root, query, retrieveSubstitutions, reversed, std::move(args)...)));
   }
 
+  /** Like iterator, but for all of @b queries at once, see BatchIterator */
+  template<class I, class TermOrLit, class InitAlgo>
+  auto batchIterator(Stack<TermOrLit> queries, bool retrieveSubstitutions, bool reversed, InitAlgo initAlgo)
+  { return isEmpty() ? VirtualIterator<ELEMENT_TYPE(I)>::getEmpty()
+                     : pvi(iterPointer(Recycled<I>(this, _root, std::move(queries), retrieveSubstitutions, reversed, std::move(initAlgo))));
+  }
+
   class LDComparator
   {
   public:
@@ -255,7 +266,8 @@ public:
   {
     UNSORTED_LIST=1,
     SKIP_LIST=2,
-    SET=3
+    SET=3,
+    SORTED_ARRAY=4
   };
 
   class Node {
@@ -402,6 +414,7 @@ public:
     //These classes and methods are defined in SubstitutionTree_Nodes.cpp
     class UListLeaf;
     class SListIntermediateNode;
+    class SArrIntermediateNode;
     class SListLeaf;
     class SetLeaf;
     static Leaf* createLeaf();
@@ -409,7 +422,19 @@ public:
     static void ensureLeafEfficiency(Leaf** l);
     static IntermediateNode* createIntermediateNode(unsigned childVar);
     static IntermediateNode* createIntermediateNode(TermList ts, unsigned childVar);
-    static void ensureIntermediateNodeEfficiency(IntermediateNode** inode);
+    void ensureIntermediateNodeEfficiency(IntermediateNode** inode);
+
+    /**
+     * Choose what intermediate nodes with many children turn into:
+     * SKIP_LIST (the default) or SORTED_ARRAY.
+     * To be called while the tree is empty.
+     */
+    void setLargeNodeAlgorithm(NodeAlgorithm alg)
+    {
+      ASS(!_root)
+      ASS(alg == SKIP_LIST || alg == SORTED_ARRAY)
+      _largeNodeAlgorithm = alg;
+    }
 
     class UArrIntermediateNode
     : public IntermediateNode
@@ -529,6 +554,85 @@ public:
       NodeSkipList _nodes;
     };
 
+    /**
+     * Intermediate node keeping its children in an array sorted by their tops,
+     * with the tops encoded as integers in an array of their own.
+     *
+     * Finding a child by top is a binary search over a few cache lines of keys,
+     * where SListIntermediateNode would chase pointers from skip list node to skip list node.
+     * The children are ordered as in SListIntermediateNode (so the variables come first),
+     * and _nodes is null-terminated as in UArrIntermediateNode.
+     */
+    class SArrIntermediateNode
+    : public IntermediateNode
+    {
+    public:
+      SArrIntermediateNode(unsigned childVar) : IntermediateNode(childVar) {}
+      SArrIntermediateNode(TermList ts, unsigned childVar) : IntermediateNode(ts, childVar) {}
+
+      ~SArrIntermediateNode()
+      {
+        if(!isEmpty()) {
+          IntermediateNode::destroyChildren();
+        }
+        if(_capacity) {
+          DEALLOC_KNOWN(_nodes, bytes(_capacity), "Indexing::SubstitutionTree::SArrIntermediateNode");
+        }
+      }
+
+      void removeAllChildren()
+      {
+        _size = 0;
+        if(_capacity) {
+          _nodes[0] = 0;
+        }
+      }
+
+      static IntermediateNode* assimilate(IntermediateNode* orig);
+
+      NodeAlgorithm algorithm() const { return SORTED_ARRAY; }
+      bool isEmpty() const { return !_size; }
+      int size() const { return _size; }
+      NodeIterator allChildren()
+      { return pvi( arrayIter(_nodes,_size).map([](Node *& n) { return &n; }) ); }
+
+      NodeIterator variableChildren()
+      {
+        return pvi( getWhileLimitedIterator(
+                      arrayIter(_nodes,_size).map([](Node *& n) { return &n; }),
+                      [](Node** n) { return (*n)->term().isVar(); }));
+      }
+      virtual Node** childByTop(TermList::Top t, bool canCreate);
+      void remove(TermList::Top t);
+
+      USE_ALLOCATOR(SArrIntermediateNode);
+
+      /** the integer encoding of @b t, ordered as TermList::Top */
+      static uint64_t key(TermList::Top t)
+      {
+        auto v = t.var();
+        if(v.isSome()) {
+          return (uint64_t(v.unwrap().number) << 1) | v.unwrap().special;
+        }
+        SymbolId f = t.functor().unwrap();
+        return (uint64_t(1) << 63) | (uint64_t(f.functor) << 8) | unsigned(f.kind);
+      }
+
+      /** the children, followed by a null pointer */
+      Node** _nodes = nullptr;
+    private:
+      /** the place of @b k in _keys: the index of the first key not less than @b k */
+      unsigned lowerBound(uint64_t k) const;
+      void grow();
+      static size_t bytes(unsigned capacity)
+      { return (capacity + 1) * sizeof(Node*) + capacity * sizeof(uint64_t); }
+
+      /** the keys of the children, in the same memory block as _nodes, just after them */
+      uint64_t* _keys = nullptr;
+      unsigned _size = 0;
+      unsigned _capacity = 0;
+    };
+
 
     class Binding {
     public:
@@ -593,6 +697,8 @@ public:
     int _nextVar = 0;
     Node* _root = nullptr;
     Cntr _iterCnt;
+    /** @see setLargeNodeAlgorithm */
+    NodeAlgorithm _largeNodeAlgorithm = SKIP_LIST;
 
   public:
 
@@ -1354,10 +1460,351 @@ public:
       { return _svStack.keepRecycled() || _nodeIterators.keepRecycled() || _bdStack.keepRecycled(); }
     };
 
+    /**
+     * Iterator retrieving the results for a whole batch of queries in a single traversal of the tree.
+     *
+     * Every query gets a RetrievalAlgorithm object of its own, the queries still matching the
+     * path to the current node are kept together, and each node is entered once for all of them.
+     * This way the queries share the enumeration of the children of the nodes they have in common,
+     * and a query that occurs several times in the batch is retrieved only once.
+     *
+     * The elements are pairs of the position of the query in the batch and the result. The results
+     * of a query are the same as with Iterator, but those of different queries are interleaved
+     * in the order of the leaves of the tree.
+     */
+    template<class RetrievalAlgorithm>
+    class BatchIterator final
+    {
+      static constexpr unsigned NO_QUERY = UINT_MAX;
+
+      struct Query {
+        RetrievalAlgorithm algo;
+        /** the bindings of the query to the initial special variables */
+        BacktrackData init;
+        /** the first position of the query in the batch, see _nextDuplicate */
+        unsigned firstId;
+      };
+
+      /** Node entered for the queries in _alive[aliveBegin..aliveEnd), and its children to be tried */
+      struct Frame {
+        unsigned specVar;
+        unsigned aliveBegin;
+        unsigned aliveEnd;
+        unsigned candidatesBegin;
+        unsigned candidatesEnd;
+        unsigned nextCandidate;
+      };
+
+      /** The queries, they must not move once retrieval has started */
+      Stack<Query> _queries;
+      /** the next position in the batch with the same query as the given one, or NO_QUERY */
+      Stack<unsigned> _nextDuplicate;
+      /** Queries that matched the nodes on the current path, a segment of them per node */
+      Stack<unsigned> _alive;
+      /** Bindings made for the elements of _alive when entering their node */
+      Stack<BacktrackData> _aliveBds;
+      Stack<Frame> _frames;
+      Stack<Node*> _candidates;
+      Stack<std::pair<Node*, unsigned>> _dedup;
+      bool _retrieveSubstitution;
+
+      Leaf* _leaf;
+      /** position in _alive of the query whose leaf data are being returned */
+      unsigned _leafPos;
+      LDIterator _leafData;
+      LeafData* _ld;
+      /** next position in the batch to return @b _ld for */
+      unsigned _nextId;
+
+      bool _normalizationRecording;
+      unsigned _normalizedQuery;
+      BacktrackData _normalizationBacktrackData;
+      InstanceCntr _iterCntr;
+    public:
+      using Unifier = typename RetrievalAlgorithm::Unifier;
+      DECL_ELEMENT_TYPE(std::pair<unsigned, QueryRes<Unifier, LeafData>>);
+
+      BatchIterator() : _leaf(nullptr), _normalizationRecording(false) {}
+
+      /**
+       * Start the retrieval for @b queries. @b initAlgo is called on the RetrievalAlgorithm
+       * object of each distinct query, with the same role as the arguments of Iterator::init.
+       */
+      template<class TermOrLit, class InitAlgo>
+      BatchIterator(SubstitutionTree* parent, Node* root, Stack<TermOrLit> queries, bool retrieveSubstitution, bool reversed, InitAlgo initAlgo)
+        : BatchIterator()
+      { init(parent, root, std::move(queries), retrieveSubstitution, reversed, std::move(initAlgo)); }
+
+      ~BatchIterator()
+      { reset(); }
+
+      template<class TermOrLit, class InitAlgo>
+      void init(SubstitutionTree* parent, Node* root, Stack<TermOrLit> queries, bool retrieveSubstitution, bool reversed, InitAlgo initAlgo)
+      {
+        ASS(_queries.isEmpty());
+        _retrieveSubstitution = retrieveSubstitution;
+        _leaf = nullptr;
+        _normalizationRecording = false;
+        _iterCntr = InstanceCntr(parent->_iterCnt);
+
+        if (!root) {
+          return;
+        }
+
+        DHMap<TermOrLit, unsigned> distinct;
+        for (unsigned i = 0; i < queries.size(); i++) {
+          _nextDuplicate.push(NO_QUERY);
+          unsigned* first;
+          if (!distinct.getValuePtr(queries[i], first)) {
+            // chain the duplicate right behind the first occurrence
+            _nextDuplicate[i] = _nextDuplicate[*first];
+            _nextDuplicate[*first] = i;
+            continue;
+          }
+          *first = i;
+          _queries.push(Query());
+          _queries.top().firstId = i;
+        }
+
+        // only now that _queries has stopped growing can we start recording
+        for (unsigned q = 0; q < _queries.size(); q++) {
+          Query& query = _queries[q];
+          initAlgo(query.algo);
+          query.algo.bdRecord(query.init);
+          parent->createBindings(queries[query.firstId], reversed,
+              [&](unsigned var, TermList t) { query.algo.bindQuerySpecialVar(var, t); });
+          query.algo.bdDone();
+          _alive.push(q);
+          _aliveBds.push(BacktrackData());
+        }
+
+        if (_queries.isNonEmpty()) {
+          enter(root, 0);
+        }
+      }
+
+      void reset()
+      {
+        undoNormalization();
+        if (_leaf) {
+          leaveLeaf();
+        }
+        while (_frames.isNonEmpty()) {
+          popFrame();
+        }
+        backtrackAlive(0);
+        for (unsigned q = 0; q < _queries.size(); q++) {
+          _queries[q].init.backtrack();
+        }
+        _queries.reset();
+        _nextDuplicate.reset();
+        _iterCntr.reset();
+      }
+
+      bool hasNext()
+      {
+        undoNormalization();
+        while (!hasLeafData() && findNextLeaf()) {}
+        return hasLeafData();
+      }
+
+      std::pair<unsigned, QueryRes<Unifier, LeafData>> next()
+      {
+        while (!hasLeafData() && findNextLeaf()) {}
+        ASS(hasLeafData());
+        ASS(!_normalizationRecording);
+
+        unsigned id = _nextId;
+        _nextId = _nextDuplicate[id];
+        unsigned q = _alive[_leafPos];
+        RetrievalAlgorithm& algo = _queries[q].algo;
+        if (_retrieveSubstitution) {
+          Renaming normalizer;
+          normalizer.normalizeVariables(_ld->key());
+
+          ASS(_normalizationBacktrackData.isEmpty());
+          algo.bdRecord(_normalizationBacktrackData);
+          _normalizationRecording = true;
+          _normalizedQuery = q;
+
+          algo.denormalize(normalizer);
+        }
+        return std::make_pair(id, QueryRes<Unifier, LeafData>(algo.unifier(), _ld));
+      }
+
+      bool keepRecycled() const
+      { return _queries.keepRecycled() || _alive.keepRecycled() || _candidates.keepRecycled() || _dedup.keepRecycled(); }
+
+    private:
+      void undoNormalization()
+      {
+        if (_normalizationRecording) {
+          _queries[_normalizedQuery].algo.bdDone();
+          _normalizationRecording = false;
+          _normalizationBacktrackData.backtrack();
+        }
+      }
+
+      bool hasLeafData()
+      {
+        if (!_leaf) {
+          return false;
+        }
+        while (_nextId == NO_QUERY) {
+          if (_leafData.hasNext()) {
+            _ld = _leafData.next();
+            _nextId = _queries[_alive[_leafPos]].firstId;
+          } else if (++_leafPos < _alive.size()) {
+            _leafData = _leaf->allChildren();
+          } else {
+            return false;
+          }
+        }
+        return true;
+      }
+
+      bool findNextLeaf()
+      {
+        if (_leaf) {
+          leaveLeaf();
+        }
+        while (_frames.isNonEmpty()) {
+          Frame& f = _frames.top();
+          if (f.nextCandidate == f.candidatesEnd) {
+            popFrame();
+            continue;
+          }
+          Node* n = _candidates[f.nextCandidate++];
+          unsigned begin = _alive.size();
+          for (unsigned i = f.aliveBegin; i < f.aliveEnd; i++) {
+            unsigned q = _alive[i];
+            RetrievalAlgorithm& algo = _queries[q].algo;
+            BacktrackData bd;
+            algo.bdRecord(bd);
+            bool success = algo.associate(f.specVar, n->term()) && (!n->isLeaf() || algo.doFinalLeafCheck());
+            algo.bdDone();
+            if (success) {
+              _alive.push(q);
+              _aliveBds.push(std::move(bd));
+            } else {
+              bd.backtrack();
+            }
+          }
+          if (_alive.size() != begin && enter(n, begin)) {
+            return true;
+          }
+        }
+        return false;
+      }
+
+      /**
+       * Enter @b n for the queries in _alive from @b aliveBegin on.
+       * Return true if @b n is a leaf.
+       */
+      bool enter(Node* n, unsigned aliveBegin)
+      {
+        if (n->isLeaf()) {
+          _leaf = static_cast<Leaf*>(n);
+          _leafPos = aliveBegin;
+          _leafData = _leaf->allChildren();
+          _nextId = NO_QUERY;
+          return true;
+        }
+
+        IntermediateNode* inode = static_cast<IntermediateNode*>(n);
+        Frame f;
+        f.specVar = inode->childVar;
+        f.aliveBegin = aliveBegin;
+        f.aliveEnd = _alive.size();
+        f.candidatesBegin = _candidates.size();
+        for (unsigned i = f.aliveBegin; i < f.aliveEnd; i++) {
+          auto it = _queries[_alive[i]].algo.template selectPotentiallyUnifiableChildren<LeafData>(inode);
+          while (it.hasNext()) {
+            _candidates.push(*it.next());
+          }
+        }
+        if (f.aliveEnd - f.aliveBegin > 1) {
+          removeDuplicateCandidates(f.candidatesBegin);
+        }
+        f.candidatesEnd = _candidates.size();
+        f.nextCandidate = f.candidatesBegin;
+        _frames.push(f);
+        return false;
+      }
+
+      /** Keep only the first occurrence of each node in _candidates from @b begin on */
+      void removeDuplicateCandidates(unsigned begin)
+      {
+        _dedup.reset();
+        for (unsigned i = begin; i < _candidates.size(); i++) {
+          _dedup.push(std::make_pair(_candidates[i], i));
+        }
+        _dedup.sort();
+        unsigned kept = 0;
+        for (unsigned i = 0; i < _dedup.size(); i++) {
+          if (i == 0 || _dedup[i].first != _dedup[i-1].first) {
+            _dedup[kept++] = _dedup[i];
+          }
+        }
+        _dedup.truncate(kept);
+        _dedup.sort([](auto& l, auto& r) { return l.second < r.second; });
+        for (unsigned i = 0; i < kept; i++) {
+          _candidates[begin + i] = _dedup[i].first;
+        }
+        _candidates.truncate(begin + kept);
+      }
+
+      void leaveLeaf()
+      {
+        ASS(!_normalizationRecording);
+        backtrackAlive(_frames.isEmpty() ? 0 : _frames.top().aliveEnd);
+        _leaf = nullptr;
+      }
+
+      void popFrame()
+      {
+        Frame f = _frames.pop();
+        _candidates.truncate(f.candidatesBegin);
+        backtrackAlive(f.aliveBegin);
+      }
+
+      void backtrackAlive(unsigned begin)
+      {
+        while (_alive.size() > begin) {
+          _alive.pop();
+          _aliveBds.pop().backtrack();
+        }
+      }
+    };
+
 
   public:
     bool maybeEmpty() const { return _root == nullptr; }
     bool isEmpty() const { return _root == nullptr || _root->isEmpty(); }
+
+    /** Add the nodes of the tree to @b shape */
+    void collectShape(IndexShape& shape)
+    {
+      if (_root) {
+        collectShape(_root, 0, shape);
+      }
+    }
+
+  private:
+    static void collectShape(Node* node, unsigned depth, IndexShape& shape)
+    {
+      if (node->isLeaf()) {
+        shape.leaves++;
+        shape.entries += node->size();
+        shape.depthSum += depth * node->size();
+        return;
+      }
+      shape.nodes[node->algorithm()]++;
+      auto children = static_cast<IntermediateNode*>(node)->allChildren();
+      while (children.hasNext()) {
+        collectShape(*children.next(), depth + 1, shape);
+      }
+    }
   }; // class SubstiutionTree
 
   /* This namespace defines classes to be used as type parameter for SubstitutionTree::Iterator. 
@@ -330,6 +330,17 @@ main_loop_start:
 	} else {
 	  sibilingsRemain=false;
 	}
+      } else if(parentType==SORTED_ARRAY) {
+	//only variable children are on the stack, and they come first in the array
+	Node** alts=static_cast<Node**>(currAlt);
+	ASS((*alts)->term().isVar());
+	curr=*(alts++);
+	if(*alts && (*alts)->term().isVar()) {
+	  _alternatives.push(alts);
+	  sibilingsRemain=true;
+	} else {
+	  sibilingsRemain=false;
+	}
       } else {
 	ASS_EQ(parentType,SKIP_LIST)
 	auto alts = static_cast<typename SListIntermediateNode::NodeSkipList::Node *>(currAlt);
@@ -465,6 +476,30 @@ bool SubstitutionTree<LeafData_>::FastGeneralizationsIterator::enterNode(Node*&
       _nodeTypes.push(currType);
       return true;
     }
+  } else if(currType==SORTED_ARRAY) {
+    Node** nl=static_cast<SArrIntermediateNode*>(inode)->_nodes;
+    ASS(*nl); //inode is not empty
+    if(binding.isTerm()) {
+      Node** byTop=inode->childByTop(binding.top(), false);
+      if(byTop) {
+	curr=*byTop;
+      }
+    }
+    if(!curr && (*nl)->term().isVar()) {
+      curr=*(nl++);
+    }
+    //as in SkipList nodes, variables are only at the beginning
+    if(!*nl || (*nl)->term().isTerm()) {
+      nl=0;
+    }
+    if(curr) {
+      _specVarNumbers.push(inode->childVar);
+    }
+    if(nl) {
+      _alternatives.push(nl);
+      _nodeTypes.push(currType);
+      return true;
+    }
   } else {
     ASS_EQ(currType, SKIP_LIST);
     auto nl=static_cast<SListIntermediateNode*>(inode)->_nodes.listLike();
@@ -417,7 +417,7 @@ main_loop_start:
       //the fact that we have alternatives means that here we are
       //matching by a variable (as there is always at most one child
       //for matching by term)
-      if(parentType==UNSORTED_LIST) {
+      if(parentType==UNSORTED_LIST || parentType==SORTED_ARRAY) {
 	Node** alts=static_cast<Node**>(currAlt);
 	curr=*(alts++);
 	if(*alts) {
@@ -561,6 +561,34 @@ bool SubstitutionTree<LeafData_>::FastInstancesIterator::enterNode(Node*& curr)
       _nodeTypes.push(currType);
       return true;
     }
+  } else if(currType==SORTED_ARRAY) {
+    Node** nl=static_cast<SArrIntermediateNode*>(inode)->_nodes;
+    ASS(*nl); //inode is not empty
+    if(query.isTerm()) {
+      //only term with the same top functor will be matched by a term
+      Node** byTop=inode->childByTop(query.top(), false);
+      if(byTop) {
+	curr=*byTop;
+      }
+      nl=0;
+    }
+    else {
+      ASS(query.isVar());
+      //everything is matched by a variable
+      curr=*(nl++);
+      if(!*nl) {
+        nl=0;
+      }
+    }
+
+    if(curr) {
+      _specVarNumbers.push(inode->childVar);
+    }
+    if(nl) {
+      _alternatives.push(nl);
+      _nodeTypes.push(currType);
+      return true;
+    }
   } else {
     ASS_EQ(currType, SKIP_LIST);
     auto nl=static_cast<SListIntermediateNode*>(inode)->_nodes.listLike();
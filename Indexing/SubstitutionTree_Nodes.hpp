@@ -13,6 +13,8 @@
  */
 
 
+#include <algorithm>
+
 #include "Lib/DHMultiset.hpp"
 #include "Lib/Exception.hpp"
 #include "Lib/List.hpp"
@@ -187,6 +189,93 @@ void SubstitutionTree<LeafData_>::UArrIntermediateNode::remove(TermList::Top t)
   ASSERTION_VIOLATION;
 }
 
+template<class LeafData_>
+unsigned SubstitutionTree<LeafData_>::SArrIntermediateNode::lowerBound(uint64_t k) const
+{
+  unsigned lo = 0;
+  unsigned hi = _size;
+  while(lo < hi) {
+    unsigned mid = (lo + hi) / 2;
+    if(_keys[mid] < k) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo;
+}
+
+/**
+ * Double the capacity of the node, moving the children and the keys into a new block.
+ */
+template<class LeafData_>
+void SubstitutionTree<LeafData_>::SArrIntermediateNode::grow()
+{
+  unsigned newCapacity = _capacity ? 2 * _capacity : 8;
+  Node** newNodes = static_cast<Node**>(ALLOC_KNOWN(bytes(newCapacity), "Indexing::SubstitutionTree::SArrIntermediateNode"));
+  uint64_t* newKeys = reinterpret_cast<uint64_t*>(newNodes + newCapacity + 1);
+  if(_capacity) {
+    std::copy(_nodes, _nodes + _size + 1, newNodes);
+    std::copy(_keys, _keys + _size, newKeys);
+    DEALLOC_KNOWN(_nodes, bytes(_capacity), "Indexing::SubstitutionTree::SArrIntermediateNode");
+  } else {
+    newNodes[0] = 0;
+  }
+  _nodes = newNodes;
+  _keys = newKeys;
+  _capacity = newCapacity;
+}
+
+template<class LeafData_>
+typename SubstitutionTree<LeafData_>::Node** SubstitutionTree<LeafData_>::SArrIntermediateNode::
+	childByTop(TermList::Top t, bool canCreate)
+{
+  uint64_t k = key(t);
+  unsigned pos = lowerBound(k);
+  if(pos < _size && _keys[pos] == k) {
+    return &_nodes[pos];
+  }
+  if(!canCreate) {
+    return 0;
+  }
+  if(_size == _capacity) {
+    grow();
+  }
+  // shift the tail, including the terminating null, to make room at pos
+  std::copy_backward(_nodes + pos, _nodes + _size + 1, _nodes + _size + 2);
+  std::copy_backward(_keys + pos, _keys + _size, _keys + _size + 1);
+  _nodes[pos] = 0;
+  _keys[pos] = k;
+  _size++;
+  return &_nodes[pos];
+}
+
+template<class LeafData_>
+void SubstitutionTree<LeafData_>::SArrIntermediateNode::remove(TermList::Top t)
+{
+  uint64_t k = key(t);
+  unsigned pos = lowerBound(k);
+  ASS(pos < _size && _keys[pos] == k);
+  std::copy(_nodes + pos + 1, _nodes + _size + 1, _nodes + pos);
+  std::copy(_keys + pos + 1, _keys + _size, _keys + pos);
+  _size--;
+}
+
+/**
+ * Take an IntermediateNode, destroy it, and return
+ * SArrIntermediateNode with the same content.
+ */
+template<class LeafData_>
+typename SubstitutionTree<LeafData_>::IntermediateNode* SubstitutionTree<LeafData_>::SArrIntermediateNode
+	::assimilate(IntermediateNode* orig)
+{
+  IntermediateNode* res = new SArrIntermediateNode(orig->term(), orig->childVar);
+  res->loadChildren(orig->allChildren());
+  orig->makeEmpty();
+  delete orig;
+  return res;
+}
+
 /**
  * Take an IntermediateNode, destroy it, and return
  * SListIntermediateNode with the same content.
@@ -231,7 +320,8 @@ template<class LeafData_>
 void SubstitutionTree<LeafData_>::ensureIntermediateNodeEfficiency(IntermediateNode** inode)
 {
   if( (*inode)->algorithm()==UNSORTED_LIST && (*inode)->size()>3 ) {
-    *inode=SListIntermediateNode::assimilate(*inode);
+    *inode = _largeNodeAlgorithm==SORTED_ARRAY ? SArrIntermediateNode::assimilate(*inode)
+                                               : SListIntermediateNode::assimilate(*inode);
   }
 }
 
@@ -33,16 +33,22 @@ public:
   virtual ~TermIndex() {}
 
   VirtualIterator<QueryRes<AbstractingUnifier*, Data>> getUwa(TypedTermList t, Options::UnificationWithAbstraction uwa, bool fixedPointIteration)
-  { return _is->getUwa(t, uwa, fixedPointIteration); }
+  { return measured([&]() { return _is->getUwa(t, uwa, fixedPointIteration); }); }
+
+  VirtualIterator<std::pair<unsigned, QueryRes<AbstractingUnifier*, Data>>> getUwaBatch(Stack<TypedTermList> queries, Options::UnificationWithAbstraction uwa, bool fixedPointIteration)
+  { return measured([&]() { return _is->getUwaBatch(std::move(queries), uwa, fixedPointIteration); }); }
 
   VirtualIterator<QueryRes<ResultSubstitutionSP, Data>> getUnifications(TypedTermList t, bool retrieveSubstitutions = true)
-  { return _is->getUnifications(t, retrieveSubstitutions); }
+  { return measured([&]() { return _is->getUnifications(t, retrieveSubstitutions); }); }
 
   VirtualIterator<QueryRes<ResultSubstitutionSP, Data>> getGeneralizations(TypedTermList t, bool retrieveSubstitutions = true)
-  { return _is->getGeneralizations(t, retrieveSubstitutions); }
+  { return measured([&]() { return _is->getGeneralizations(t, retrieveSubstitutions); }); }
 
   VirtualIterator<QueryRes<ResultSubstitutionSP, Data>> getInstances(TypedTermList t, bool retrieveSubstitutions = true)
-  { return _is->getInstances(t, retrieveSubstitutions); }
+  { return measured([&]() { return _is->getInstances(t, retrieveSubstitutions); }); }
+
+  void collectShape(IndexShape& shape) override
+  { _is->collectShape(shape); }
 
   friend std::ostream& operator<<(std::ostream& out, TermIndex const& self)
   { return out << *self._is; }
@@ -17,6 +17,7 @@
 #define __TermIndexingStructure__
 
 #include "Index.hpp"
+#include "Lib/PairUtils.hpp"
 
 namespace Indexing {
 
@@ -31,12 +32,26 @@ public:
 
   virtual VirtualIterator<QueryRes<ResultSubstitutionSP, Data>> getUnifications(TypedTermList t, bool retrieveSubstitutions = true) { NOT_IMPLEMENTED; }
   virtual VirtualIterator<QueryRes<AbstractingUnifier*, Data>> getUwa(TypedTermList t, Options::UnificationWithAbstraction uwa, bool fixedPointIteration) = 0;
+  /**
+   * Retrieve the results of getUwa for all of @b queries, as pairs of the position of the query and a result.
+   * This default implementation retrieves them one query after another.
+   */
+  virtual VirtualIterator<std::pair<unsigned, QueryRes<AbstractingUnifier*, Data>>> getUwaBatch(Stack<TypedTermList> queries, Options::UnificationWithAbstraction uwa, bool fixedPointIteration)
+  {
+    unsigned cnt = queries.size();
+    return pvi(range(0, cnt)
+        .flatMap([this, queries = std::move(queries), uwa, fixedPointIteration](unsigned i)
+          { return pushPairIntoRightIterator(i, getUwa(queries[i], uwa, fixedPointIteration)); }));
+  }
   virtual VirtualIterator<QueryRes<ResultSubstitutionSP, Data>> getUnificationsUsingSorts(TypedTermList tt, bool retrieveSubstitutions = true) { NOT_IMPLEMENTED; }  
   virtual VirtualIterator<QueryRes<ResultSubstitutionSP, Data>> getGeneralizations(TypedTermList t, bool retrieveSubstitutions = true) { NOT_IMPLEMENTED; }
   virtual VirtualIterator<QueryRes<ResultSubstitutionSP, Data>> getInstances(TypedTermList t, bool retrieveSubstitutions = true) { NOT_IMPLEMENTED; }
 
   virtual bool generalizationExists(TermList t) { NOT_IMPLEMENTED; }
 
+  /** Add the nodes of the structure to @b shape, if it has nodes */
+  virtual void collectShape(IndexShape& shape) {}
+
   virtual void output(std::ostream& output) const = 0;
 
   friend std::ostream& operator<<(std::ostream& out, TermIndexingStructure const& self)
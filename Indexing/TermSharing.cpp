@@ -52,11 +52,11 @@ TermSharing::TermSharing()
 TermSharing::~TermSharing()
 {
 #if CHECK_LEAKS
-  Set<Term*,TermSharing>::Iterator ts(_terms);
+  StripedSet<Term*,TermSharing>::Iterator ts(_terms);
   while (ts.hasNext()) {
     ts.next()->destroy();
   }
-  Set<Literal*,TermSharing>::Iterator ls(_literals);
+  StripedSet<Literal*,TermSharing>::Iterator ls(_literals);
   while (ls.hasNext()) {
     ls.next()->destroy();
   }
@@ -88,6 +88,7 @@ void TermSharing::computeAndSetSharedTermData(Term* t)
     bool hasInterpretedConstants=t->arity()==0 &&
 	env.signature->getFunction(t->functor())->interpreted();
     bool hasTermVar = false;
+    unsigned varMask = 0;
     Color color = COLOR_TRANSPARENT;
 
     if(env.options->combinatorySup()){ 
@@ -141,6 +142,7 @@ void TermSharing::computeAndSetSharedTermData(Term* t)
         }
         vars++;
         weight += 1;
+        varMask |= Term::varMaskBit(tt->var());
       }
       else 
       {
@@ -152,6 +154,7 @@ void TermSharing::computeAndSetSharedTermData(Term* t)
         vars += r->numVarOccs();
         weight += r->weight();
         hasTermVar |= r->hasTermVar();
+        varMask |= r->varMask();
         if (env.colorUsed) {
           color = static_cast<Color>(color | r->color());
         }
@@ -165,6 +168,7 @@ void TermSharing::computeAndSetSharedTermData(Term* t)
     t->setNumVarOccs(vars);
     t->setWeight(weight);
     t->setHasTermVar(hasTermVar);
+    t->setVarMask(varMask);
     if (env.colorUsed) {
       Color fcolor = env.signature->getFunction(t->functor())->color();
       color = static_cast<Color>(color | fcolor);
@@ -197,12 +201,14 @@ void TermSharing::computeAndSetSharedSortData(AtomicSort* sort)
     }
     unsigned weight = 1;
     unsigned vars = 0;
+    unsigned varMask = 0;
 
     for (TermList* tt = sort->args(); ! tt->isEmpty(); tt = tt->next()) {
       if (tt->isVar()) {
         ASS(tt->isOrdinaryVar());
         vars++;
         weight += 1;
+        varMask |= Term::varMaskBit(tt->var());
       }
       else 
       {
@@ -212,12 +218,14 @@ void TermSharing::computeAndSetSharedSortData(AtomicSort* sort)
   
         vars += r->numVarOccs();
         weight += r->weight();
+        varMask |= r->varMask();
       }
     }
     sort->markShared();
     sort->setId(_sorts.size());
     sort->setNumVarOccs(vars);
     sort->setWeight(weight);
+    sort->setVarMask(varMask);
 
     ASS_REP(SortHelper::allTopLevelArgsAreSorts(sort), sort->toString());
     if (!SortHelper::allTopLevelArgsAreSorts(sort)){
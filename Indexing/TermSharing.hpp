@@ -18,6 +18,7 @@
 #define __TermSharing__
 
 #include "Lib/Set.hpp"
+#include "Lib/StripedSet.hpp"
 #include "Kernel/Term.hpp"
 
 #include "Lib/Allocator.hpp"
@@ -99,10 +100,10 @@ private:
   int sumRedLengths(TermStack& args);
   static bool argNormGt(TermList t1, TermList t2);
 
-  /** The set storing all terms */
-  Set<Term*,TermSharing> _terms;
+  /** The set storing all terms (striped, as it can get really big) */
+  StripedSet<Term*,TermSharing> _terms;
   /** The set storing all literals */
-  Set<Literal*,TermSharing> _literals;
+  StripedSet<Literal*,TermSharing> _literals;
   /** The set storing all sorts */
   Set<AtomicSort*,TermSharing> _sorts;
   /* Set containing all array sorts. 
@@ -54,11 +54,17 @@ class TermSubstitutionTree
   Indexing::SubstitutionTree<LeafData_> _inner;
 public:
   using LeafData = LeafData_;
+  using NodeAlgorithm = typename SubstitutionTree::NodeAlgorithm;
   
   TermSubstitutionTree()
     : _inner()
     { }
 
+  /** A tree whose intermediate nodes with many children become @b largeNodes, see SubstitutionTree::setLargeNodeAlgorithm */
+  explicit TermSubstitutionTree(NodeAlgorithm largeNodes)
+    : _inner()
+    { _inner.setLargeNodeAlgorithm(largeNodes); }
+
   void handle(LeafData d, bool insert) final override
   { _inner.handle(std::move(d), insert); }
 
@@ -74,6 +80,8 @@ private:
 
   virtual void output(std::ostream& out) const final override { out << *this; }
 
+  void collectShape(IndexShape& shape) final override { _inner.collectShape(shape); }
+
   friend std::ostream& operator<<(std::ostream& out, TermSubstitutionTree<LeafData_> const& self)
   { return out << self._inner; }
   friend std::ostream& operator<<(std::ostream& out, Output::Multiline<TermSubstitutionTree<LeafData_>> const& self)
@@ -90,6 +98,11 @@ public:
   VirtualIterator<QueryRes<AbstractingUnifier*, LeafData>> getUwa(TypedTermList t, Options::UnificationWithAbstraction uwa, bool fixedPointIteration) final override
   { return pvi(getResultIterator<typename SubstitutionTree::template Iterator<RetrievalAlgorithms::UnificationWithAbstraction<AbstractingUnifier, RetrievalAlgorithms::DefaultVarBanks>>>(t, /* retrieveSubstitutions */ true, AbstractingUnifier::empty(AbstractionOracle(uwa)), AbstractionOracle(uwa), fixedPointIteration)); }
 
+  VirtualIterator<std::pair<unsigned, QueryRes<AbstractingUnifier*, LeafData>>> getUwaBatch(Stack<TypedTermList> queries, Options::UnificationWithAbstraction uwa, bool fixedPointIteration) final override
+  { return _inner.template batchIterator<typename SubstitutionTree::template BatchIterator<RetrievalAlgorithms::UnificationWithAbstraction<AbstractingUnifier, RetrievalAlgorithms::DefaultVarBanks>>>(
+        std::move(queries), /* retrieveSubstitutions */ true, /* reversed */ false,
+        [=](auto& algo) { algo.init(AbstractingUnifier::empty(AbstractionOracle(uwa)), AbstractionOracle(uwa), fixedPointIteration); }); }
+
   template<class VarBanks>
   VirtualIterator<QueryRes<AbstractingUnifier*, LeafData>> getUwa(AbstractingUnifier* state, TypedTermList t, Options::UnificationWithAbstraction uwa, bool fixedPointIteration)
   { return pvi(getResultIterator<typename SubstitutionTree::template Iterator<RetrievalAlgorithms::UnificationWithAbstraction<AbstractingUnifier*, VarBanks>>>(t, /* retrieveSubstitutions */ true, state, AbstractionOracle(uwa), fixedPointIteration)); }
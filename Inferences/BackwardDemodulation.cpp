@@ -102,7 +102,7 @@ struct BackwardDemodulation::ResultFn
   typedef DHMultiset<Clause*> ClauseSet;
 
   ResultFn(Clause* cl, BackwardDemodulation& parent, const DemodulationHelper& helper)
-  : _cl(cl), _helper(helper), _ordering(parent._salg->getOrdering())
+  : _cl(cl), _index(parent._index), _helper(helper), _ordering(parent._salg->getOrdering())
   {
     ASS_EQ(_cl->length(),1);
     _eqLit=(*_cl)[0];
@@ -159,6 +159,7 @@ struct BackwardDemodulation::ResultFn
     if(EqHelper::isEqTautology(resLit)) {
       env.statistics->backwardDemodulationsToEqTaut++;
       _removed->insert(qr.data->clause);
+      _index->recordAccepted();
       return BwSimplificationRecord(qr.data->clause);
     }
 
@@ -176,6 +177,7 @@ struct BackwardDemodulation::ResultFn
 
     env.statistics->backwardDemodulations++;
     _removed->insert(qr.data->clause);
+    _index->recordAccepted();
     Clause *replacement = Clause::fromStack(
       *resLits,
       SimplifyingInference2(InferenceRule::BACKWARD_DEMODULATION, qr.data->clause, _cl)
@@ -187,6 +189,7 @@ struct BackwardDemodulation::ResultFn
 private:
   Literal* _eqLit;
   Clause* _cl;
+  DemodulationSubtermIndex* _index;
   SmartPtr<ClauseSet> _removed;
 
   const DemodulationHelper& _helper;
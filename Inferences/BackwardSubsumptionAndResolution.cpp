@@ -26,6 +26,7 @@
 #include "Kernel/Clause.hpp"
 #include "Lib/List.hpp"
 #include "Indexing/Index.hpp"
+#include "Indexing/FeatureVectorIndex.hpp"
 #include "Indexing/LiteralIndex.hpp"
 #include "Indexing/IndexManager.hpp"
 #include "Saturation/SaturationAlgorithm.hpp"
@@ -45,12 +46,17 @@ void BackwardSubsumptionAndResolution::attach(SaturationAlgorithm *salg)
   _bwIndex = static_cast<BackwardSubsumptionIndex *>(
       _salg->getIndexManager()->request(BACKWARD_SUBSUMPTION_SUBST_TREE)
   );
+  _fvIndex = static_cast<FeatureVectorIndex *>(
+      _salg->getIndexManager()->request(BACKWARD_SUBSUMPTION_FEATURE_VECTORS)
+  );
 }
 
 void BackwardSubsumptionAndResolution::detach()
 {
   _bwIndex = 0;
+  _fvIndex = 0;
   _salg->getIndexManager()->release(BACKWARD_SUBSUMPTION_SUBST_TREE);
+  _salg->getIndexManager()->release(BACKWARD_SUBSUMPTION_FEATURE_VECTORS);
   BackwardSimplificationEngine::detach();
 }
 
@@ -141,6 +147,10 @@ void BackwardSubsumptionAndResolution::perform(Clause *cl,
     }
   }
 
+  // The candidates are first compared by their feature vectors, which rules out
+  // most of them without setting up the SAT-based check.
+  FeatureVector features(cl);
+
   if (!_subsumptionByUnitsOnly) {
     // find the positively matched literals
     auto it = _bwIndex->getInstances(lit, false, false);
@@ -149,8 +159,12 @@ void BackwardSubsumptionAndResolution::perform(Clause *cl,
       if (!_checked.insert(icl))
         continue;
       // check subsumption and setup subsumption resolution at the same time
-      bool checkS = _subsumption && !_subsumptionByUnitsOnly;
-      bool checkSR = _subsumptionResolution && !_srByUnitsOnly;
+      bool checkS = _subsumption && !_subsumptionByUnitsOnly && _fvIndex->maySubsume(features, icl);
+      bool checkSR = _subsumptionResolution && !_srByUnitsOnly && _fvIndex->mayResolve(features, icl);
+      if (!checkS && !checkSR) {
+        env.statistics->backwardSubsumptionCandidatesFiltered++;
+        continue;
+      }
       if (checkS) {
         if (_satSubs.checkSubsumption(cl, icl, checkSR)) {
           env.statistics->backwardSubsumed++;
@@ -181,6 +195,10 @@ void BackwardSubsumptionAndResolution::perform(Clause *cl,
       Clause *icl = it.next().data->clause;
       if (!_checked.insert(icl))
         continue;
+      if (!_fvIndex->mayResolve(features, icl)) {
+        env.statistics->backwardSubsumptionCandidatesFiltered++;
+        continue;
+      }
       // check subsumption resolution
       Clause *conclusion = _satSubs.checkSubsumptionResolution(cl, icl, false);
       if (conclusion) {
@@ -18,6 +18,7 @@
 #include "Lib/DHSet.hpp"
 #include "InferenceEngine.hpp"
 #include "Indexing/LiteralIndex.hpp"
+#include "Indexing/FeatureVectorIndex.hpp"
 #include "SATSubsumption/SATSubsumptionAndResolution.hpp"
 
 namespace Inferences {
@@ -49,6 +50,8 @@ private:
 
   /// @brief Backward index for subsumption and subsumption resolution candidates
   Indexing::BackwardSubsumptionIndex *_bwIndex;
+  /// @brief Feature vectors of the clauses in _bwIndex, to rule out candidates cheaply
+  Indexing::FeatureVectorIndex *_fvIndex;
   /// @brief SAT-based subsumption and subsumption resolution engine
   SATSubsumption::SATSubsumptionAndResolution _satSubs;
   /// @brief Set of clauses that have already been checked for subsumption and/or subsumption resolution
@@ -0,0 +1,83 @@
+/*
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ */
+/**
+ * @file FeatureVectorForwardSubsumptionAndResolution.cpp
+ * Implements class FeatureVectorForwardSubsumptionAndResolution.
+ */
+
+#include "Saturation/SaturationAlgorithm.hpp"
+#include "Shell/Statistics.hpp"
+
+#include "FeatureVectorForwardSubsumptionAndResolution.hpp"
+
+namespace Inferences {
+
+using namespace Indexing;
+
+void FeatureVectorForwardSubsumptionAndResolution::attach(SaturationAlgorithm *salg)
+{
+  ForwardSimplificationEngine::attach(salg);
+  _index = static_cast<FwSubsFeatureVectorIndex*>(
+    _salg->getIndexManager()->request(FW_SUBSUMPTION_FEATURE_VECTORS));
+}
+
+void FeatureVectorForwardSubsumptionAndResolution::detach()
+{
+  _index = nullptr;
+  _salg->getIndexManager()->release(FW_SUBSUMPTION_FEATURE_VECTORS);
+  ForwardSimplificationEngine::detach();
+}
+
+bool FeatureVectorForwardSubsumptionAndResolution::perform(Clause *cl, Clause *&replacement, ClauseIterator &premises)
+{
+  TIME_TRACE("forward subsumption");
+
+  if (cl->length() == 0 || _index->isEmpty()) {
+    return false;
+  }
+
+  FeatureVector query(cl);
+  Clause* conclusion = nullptr;
+  Clause* premise = nullptr;
+
+  // As in ForwardSubsumptionAndResolution, a subsumption resolution is kept
+  // until all the candidates have been tried for subsumption.
+  bool subsumed = _index->visitCandidates(query, _subsumptionResolution, [&](Clause* mcl, const FeatureVector& vector) {
+    env.statistics->forwardSubsumptionCandidates++;
+    bool checkSR = _subsumptionResolution && !conclusion;
+    bool checkS = vector.maySubsume(query);
+    if (checkS && _satSubs.checkSubsumption(mcl, cl, checkSR)) {
+      premise = mcl;
+      return true;
+    }
+    if (checkSR) {
+      conclusion = _satSubs.checkSubsumptionResolution(mcl, cl, checkS);
+      if (conclusion) {
+        premise = mcl;
+      }
+    }
+    return false;
+  });
+
+  if (subsumed) {
+    premises = pvi(getSingletonIterator(premise));
+    env.statistics->forwardSubsumed++;
+    return true;
+  }
+  if (conclusion) {
+    replacement = conclusion;
+    premises = pvi(getSingletonIterator(premise));
+    env.statistics->forwardSubsumptionResolution++;
+    return true;
+  }
+  return false;
+}
+
+} // namespace Inferences
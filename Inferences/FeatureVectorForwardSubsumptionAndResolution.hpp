@@ -0,0 +1,50 @@
+/*
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ */
+/**
+ * @file FeatureVectorForwardSubsumptionAndResolution.hpp
+ * Defines class FeatureVectorForwardSubsumptionAndResolution.
+ */
+
+#ifndef __FeatureVectorForwardSubsumptionAndResolution__
+#define __FeatureVectorForwardSubsumptionAndResolution__
+
+#include "Inferences/InferenceEngine.hpp"
+#include "Indexing/FeatureVectorIndex.hpp"
+#include "SATSubsumption/SATSubsumptionAndResolution.hpp"
+
+namespace Inferences {
+
+/**
+ * Forward subsumption and subsumption resolution with the candidates
+ * retrieved from a feature vector index instead of a code tree or
+ * substitution trees, each of them checked by SAT-based subsumption.
+ */
+class FeatureVectorForwardSubsumptionAndResolution
+  : public ForwardSimplificationEngine
+{
+public:
+  FeatureVectorForwardSubsumptionAndResolution(bool subsumptionResolution) : _subsumptionResolution(subsumptionResolution) {}
+
+  void attach(Saturation::SaturationAlgorithm *salg) override;
+  void detach() override;
+
+  bool perform(Kernel::Clause *cl,
+               Kernel::Clause *&replacement,
+               Kernel::ClauseIterator &premises) override;
+
+private:
+  bool _subsumptionResolution;
+  Indexing::FwSubsFeatureVectorIndex* _index;
+  SATSubsumption::SATSubsumptionAndResolution _satSubs;
+};
+
+}; // namespace Inferences
+
+#endif /* __FeatureVectorForwardSubsumptionAndResolution__ */
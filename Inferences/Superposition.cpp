@@ -114,8 +114,24 @@ private:
 };
 
 
+/**
+ * Return the unifiers of the terms in @b queries with the terms in @b index,
+ * each paired with the query (and the literal it comes from) it unifies with.
+ */
+static auto unificationsOf(TermIndex<TermLiteralClause>& index, Stack<pair<Literal*, TypedTermList>> queries)
+{
+  auto terms = iterTraits(queries.iterFifo())
+    .map([](pair<Literal*, TypedTermList> q) { return q.second; })
+    .collect<Stack>();
+  return iterTraits(index.getUwaBatch(std::move(terms), env.options->unificationWithAbstraction(), env.options->unificationWithAbstractionFixedPointIteration()))
+    .map([queries = std::move(queries)](auto res) { return std::make_pair(queries[res.first], res.second); });
+}
+
 ClauseIterator Superposition::generateClauses(Clause* premise)
 {
+  // the queries are collected eagerly, the retrieval itself is timed by the iterator below
+  TIME_TRACE("superposition");
+
   auto itf1 = premise->getSelectedLiteralIterator();
 
   // Get an iterator of pairs of selected literals and rewritable subterms of those literals
@@ -128,21 +144,22 @@ ClauseIterator Superposition::generateClauses(Clause* premise)
                                                                             : EqHelper::getSubtermIterator(lit,  _salg->getOrdering())); });
 
   // Get clauses with a literal whose complement unifies with the rewritable subterm,
-  // returns a pair with the original pair and the unification result (includes substitution)
-  auto itf3 = getMapAndFlattenIterator(itf2,
-      [this](pair<Literal*, TypedTermList> arg)
-      { return pushPairIntoRightIterator(arg, _lhsIndex->getUwa(arg.second, env.options->unificationWithAbstraction(), env.options->unificationWithAbstractionFixedPointIteration())); });
+  // returns a pair with the original pair and the unification result (includes substitution).
+  // All the subterms are looked up in a single traversal of the index.
+  auto rewritable = iterTraits(itf2)
+    .map([](pair<Literal*, Term*> arg) { return std::make_pair(arg.first, TypedTermList(arg.second)); })
+    .collect<Stack>();
+  auto itf3 = unificationsOf(*_lhsIndex, std::move(rewritable));
 
   //Perform forward superposition
   auto itf4 = getMappingIterator(itf3,ForwardResultFn(premise, *this));
 
   auto itb1 = premise->getSelectedLiteralIterator();
   auto itb2 = getMapAndFlattenIterator(itb1,EqHelper::SuperpositionLHSIteratorFn(_salg->getOrdering(), _salg->getOptions()));
-  auto itb3 = getMapAndFlattenIterator(itb2,
-      [this] (pair<Literal*, TermList> arg)
-      { return pushPairIntoRightIterator(
-              arg,
-              _subtermIndex->getUwa(TypedTermList(arg.second, SortHelper::getEqualityArgumentSort(arg.first)), env.options->unificationWithAbstraction(), env.options->unificationWithAbstractionFixedPointIteration())); });
+  auto lhss = iterTraits(itb2)
+    .map([](pair<Literal*, TermList> arg) { return std::make_pair(arg.first, TypedTermList(arg.second, SortHelper::getEqualityArgumentSort(arg.first))); })
+    .collect<Stack>();
+  auto itb3 = unificationsOf(*_subtermIndex, std::move(lhss));
 
   //Perform backward superposition
   auto itb4 = getMappingIterator(itb3,BackwardResultFn(premise, *this));
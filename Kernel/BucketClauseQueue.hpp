@@ -0,0 +1,332 @@
+/*
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ */
+/**
+ * @file BucketClauseQueue.hpp
+ * Defines class BucketClauseQueue.
+ */
+
+#ifndef __BucketClauseQueue__
+#define __BucketClauseQueue__
+
+#include <cstdint>
+
+#include "Debug/Assertion.hpp"
+
+#include "Lib/Reflection.hpp"
+#include "Lib/Stack.hpp"
+
+namespace Kernel {
+
+using namespace Lib;
+
+class Clause;
+
+/**
+ * A queue of clauses for the selection from passive, organised as buckets.
+ *
+ * The order of the queue is given by the class @b Order deriving from it, which provides
+ * - std::uint64_t bucketKey(C*): a clause with a smaller key comes first;
+ * - std::uint64_t entryKey(C*), which orders the clauses with the same bucket key
+ *   and is different for any two clauses in the queue.
+ * The clauses are of the type @b C, which is Clause or its compact form CompactClause.
+ *
+ * The clauses with the same bucket key form a bucket, an array sorted by the entry keys.
+ * The entry keys are stored with the clauses, so removed clauses, which may
+ * have been destroyed in the meantime, are never looked at.
+ * The keys of the passive orders are made of ages and weights, small integers,
+ * so the buckets are few and the clauses mostly come to the end of their bucket.
+ * Inserting a clause is then a binary search over the bucket keys and a push,
+ * and taking the first clause takes constant time.
+ *
+ * Removed clauses are only marked in their bucket and skipped, until the
+ * bucket is compacted when more than half of it is removed.
+ */
+template<class Order, class C = Clause>
+class BucketClauseQueue
+{
+public:
+  BucketClauseQueue() {}
+  ~BucketClauseQueue()
+  {
+    for (Bucket* b : _buckets) {
+      delete b;
+    }
+  }
+
+  void insert(C* cl);
+  bool remove(C* cl);
+  C* pop();
+  /** Return the first clause without removing it */
+  C* top() const
+  {
+    ASS(!isEmpty());
+    Bucket* b = _buckets.top();
+    return b->entries[b->first].clause();
+  }
+  /** True if the queue is empty */
+  bool isEmpty() const { return _buckets.isEmpty(); }
+
+  /** Does @b c1 come before @b c2 in the order of the queue? */
+  template<class C1, class C2>
+  bool lessThan(C1* c1, C2* c2) const
+  {
+    std::uint64_t k1 = order().bucketKey(c1);
+    std::uint64_t k2 = order().bucketKey(c2);
+    return k1 < k2 || (k1 == k2 && order().entryKey(c1) < order().entryKey(c2));
+  }
+
+private:
+  /** A clause in a bucket with its entry key, the lowest bit of the pointer set if the clause was removed */
+  class Entry
+  {
+  public:
+    Entry(C* cl, std::uint64_t key) : _content(reinterpret_cast<std::uintptr_t>(cl)), _key(key) {}
+    C* clause() const { return reinterpret_cast<C*>(_content & ~std::uintptr_t(1)); }
+    std::uint64_t key() const { return _key; }
+    bool removed() const { return _content & 1; }
+    void setRemoved(bool removed) { _content = (_content & ~std::uintptr_t(1)) | removed; }
+  private:
+    std::uintptr_t _content;
+    std::uint64_t _key;
+  };
+
+  struct Bucket
+  {
+    Bucket(std::uint64_t key) : key(key), first(0), live(0) {}
+
+    std::uint64_t key;
+    /** the clauses sorted by their entry keys; those before @b first were popped */
+    Stack<Entry> entries;
+    /** index of the first clause, which is not removed */
+    unsigned first;
+    /** number of clauses that are not removed */
+    unsigned live;
+  };
+
+  Order& order() { return static_cast<Order&>(*this); }
+  const Order& order() const { return static_cast<const Order&>(*this); }
+
+  /**
+   * Return the index of the bucket with @b key in _buckets,
+   * or if there is none, the index where it would be inserted.
+   */
+  unsigned bucketIndex(std::uint64_t key) const
+  {
+    // the buckets are sorted by decreasing keys
+    unsigned lo = 0;
+    unsigned hi = _buckets.size();
+    while (lo < hi) {
+      unsigned mid = (lo + hi) / 2;
+      if (_buckets[mid]->key > key) {
+        lo = mid + 1;
+      } else {
+        hi = mid;
+      }
+    }
+    return lo;
+  }
+
+  /** Return the index of the first entry of @b b with an entry key not less than @b key */
+  static unsigned entryIndex(Bucket* b, std::uint64_t key)
+  {
+    unsigned lo = b->first;
+    unsigned hi = b->entries.size();
+    while (lo < hi) {
+      unsigned mid = (lo + hi) / 2;
+      if (b->entries[mid].key() < key) {
+        lo = mid + 1;
+      } else {
+        hi = mid;
+      }
+    }
+    return lo;
+  }
+
+  /** Move @b first to the first clause that is not removed, and compact @b b if it is mostly removed */
+  static void normalize(Bucket* b)
+  {
+    ASS_G(b->live, 0);
+    while (b->entries[b->first].removed()) {
+      b->first++;
+    }
+    if (b->live * 2 >= b->entries.size()) {
+      return;
+    }
+    unsigned kept = 0;
+    for (unsigned i = b->first; i < b->entries.size(); i++) {
+      if (!b->entries[i].removed()) {
+        b->entries[kept++] = b->entries[i];
+      }
+    }
+    b->entries.truncate(kept);
+    b->first = 0;
+  }
+
+  /** Remove the empty bucket at @b index */
+  void removeBucket(unsigned index)
+  {
+    ASS_EQ(_buckets[index]->live, 0);
+    delete _buckets[index];
+    for (unsigned i = index + 1; i < _buckets.size(); i++) {
+      _buckets[i - 1] = _buckets[i];
+    }
+    _buckets.pop();
+  }
+
+  /** the non-empty buckets sorted by decreasing keys, so that the first clause is in the last one */
+  Stack<Bucket*> _buckets;
+
+public:
+  /** Iterator over the queue in its order */
+  class Iterator {
+  public:
+    DECL_ELEMENT_TYPE(C*);
+
+    /** Create a new iterator */
+    explicit Iterator(BucketClauseQueue& queue)
+      : _buckets(&queue._buckets), _bucket(queue._buckets.size()), _entry(0)
+    {
+      if (_bucket) {
+        _bucket--;
+        _entry = (*_buckets)[_bucket]->first;
+      }
+    }
+    /** true if there is a next clause */
+    bool hasNext() const
+    { return _bucket < _buckets->size() && _entry < (*_buckets)[_bucket]->entries.size(); }
+    /** return the next clause */
+    C* next()
+    {
+      ASS(hasNext());
+      C* res = (*_buckets)[_bucket]->entries[_entry].clause();
+      advance();
+      return res;
+    }
+  private:
+    /** move to the next clause that is not removed */
+    void advance()
+    {
+      Bucket* b = (*_buckets)[_bucket];
+      do {
+        _entry++;
+      } while (_entry < b->entries.size() && b->entries[_entry].removed());
+      if (_entry == b->entries.size() && _bucket > 0) {
+        _bucket--;
+        _entry = (*_buckets)[_bucket]->first;
+      }
+    }
+
+    const Stack<Bucket*>* _buckets;
+    unsigned _bucket;
+    unsigned _entry;
+  }; // class BucketClauseQueue::Iterator
+}; // class BucketClauseQueue
+
+/**
+ * Insert @b cl into the queue, it must not be there already
+ */
+template<class Order, class C>
+void BucketClauseQueue<Order, C>::insert(C* cl)
+{
+  std::uint64_t key = order().bucketKey(cl);
+  unsigned bi = bucketIndex(key);
+  if (bi == _buckets.size() || _buckets[bi]->key != key) {
+    _buckets.push(nullptr);
+    for (unsigned i = _buckets.size() - 1; i > bi; i--) {
+      _buckets[i] = _buckets[i - 1];
+    }
+    _buckets[bi] = new Bucket(key);
+  }
+  Bucket* b = _buckets[bi];
+  b->live++;
+
+  Stack<Entry>& entries = b->entries;
+  std::uint64_t ekey = order().entryKey(cl);
+  Entry entry(cl, ekey);
+  if (entries.size() == b->first || entries.top().key() < ekey) {
+    // the common case
+    entries.push(entry);
+    return;
+  }
+  unsigned ei = entryIndex(b, ekey);
+  // a removed entry may have the key of a clause destroyed since, reused by cl
+  for (unsigned i = ei; i < entries.size() && entries[i].key() == ekey; i++) {
+    if (entries[i].clause() == cl) {
+      // inserted back after being removed
+      ASS(entries[i].removed());
+      entries[i].setRemoved(false);
+      return;
+    }
+  }
+  if (ei == b->first && b->first > 0) {
+    entries[--b->first] = entry;
+    return;
+  }
+  entries.push(entry);
+  for (unsigned i = entries.size() - 1; i > ei; i--) {
+    entries[i] = entries[i - 1];
+  }
+  entries[ei] = entry;
+}
+
+/**
+ * Remove @b cl from the queue and return true, or return false if it is not there
+ */
+template<class Order, class C>
+bool BucketClauseQueue<Order, C>::remove(C* cl)
+{
+  std::uint64_t key = order().bucketKey(cl);
+  unsigned bi = bucketIndex(key);
+  if (bi == _buckets.size() || _buckets[bi]->key != key) {
+    return false;
+  }
+  Bucket* b = _buckets[bi];
+  std::uint64_t ekey = order().entryKey(cl);
+  unsigned ei = entryIndex(b, ekey);
+  while (ei < b->entries.size() && b->entries[ei].key() == ekey
+      && (b->entries[ei].clause() != cl || b->entries[ei].removed())) {
+    ei++;
+  }
+  if (ei == b->entries.size() || b->entries[ei].key() != ekey) {
+    return false;
+  }
+  b->entries[ei].setRemoved(true);
+  b->live--;
+  if (b->live == 0) {
+    removeBucket(bi);
+  } else {
+    normalize(b);
+  }
+  return true;
+}
+
+/**
+ * Remove the first clause from the queue and return it
+ */
+template<class Order, class C>
+C* BucketClauseQueue<Order, C>::pop()
+{
+  ASS(!isEmpty());
+
+  Bucket* b = _buckets.top();
+  C* res = b->entries[b->first].clause();
+  b->first++;
+  b->live--;
+  if (b->live == 0) {
+    removeBucket(_buckets.size() - 1);
+  } else {
+    normalize(b);
+  }
+  return res;
+}
+
+} // namespace Kernel
+
+#endif // __BucketClauseQueue__
@@ -79,6 +79,7 @@ Clause::Clause(Literal* const* lits, unsigned length, Inference inf)
     _reductionTimestamp(0),
     _literalPositions(0),
     _numActiveSplits(0),
+    _variantHash(0),
     _auxTimestamp(0)
 {
   // MS: TODO: not sure if this belongs here and whether EXTENSIONALITY_AXIOM input types ever appear anywhere (as a vampire-extension TPTP formula role)
@@ -95,6 +96,142 @@ Clause::Clause(Literal* const* lits, unsigned length, Inference inf)
   doUnitTracing();
 }
 
+/**
+ * The number of bytes taken by a clause with @b length literals.
+ */
+static constexpr size_t clauseBytes(unsigned length)
+{
+  //We have to get sizeof(Clause) + (_length-1)*sizeof(Literal*)
+  //this way, because _length-1 wouldn't behave well for
+  //_length==0 on x64 platform.
+  return sizeof(Clause) + length * sizeof(Literal*) - sizeof(Literal*);
+}
+
+#ifndef INDIVIDUAL_ALLOCATIONS
+/*
+ * Clauses are too big for the global small-object allocator, which would pass them all on
+ * to the system allocator. Yet most clauses are short, and most of those are short-lived:
+ * the bulk of the generated clauses gets discarded by forward simplification or the passive limits
+ * soon after being created. So short clauses get fixed-size allocators of their own,
+ * which hand the memory of a discarded clause to the next clause of the same length,
+ * while it is still in the cache.
+ */
+class ClauseAllocator {
+public:
+  static const unsigned MAX_LENGTH = 6;
+
+  void* alloc(unsigned length) {
+    switch(length) {
+      case 0: return _fsa0.alloc();
+      case 1: return _fsa1.alloc();
+      case 2: return _fsa2.alloc();
+      case 3: return _fsa3.alloc();
+      case 4: return _fsa4.alloc();
+      case 5: return _fsa5.alloc();
+      case 6: return _fsa6.alloc();
+      default: return Lib::alloc(clauseBytes(length));
+    }
+  }
+
+  void free(void* ptr, unsigned length) {
+    switch(length) {
+      case 0: return _fsa0.free(ptr);
+      case 1: return _fsa1.free(ptr);
+      case 2: return _fsa2.free(ptr);
+      case 3: return _fsa3.free(ptr);
+      case 4: return _fsa4.free(ptr);
+      case 5: return _fsa5.free(ptr);
+      case 6: return _fsa6.free(ptr);
+      default: Lib::free(ptr, clauseBytes(length));
+    }
+  }
+
+  // see SmallObjectAllocator::seal
+  void seal() {
+    _fsa0.seal();
+    _fsa1.seal();
+    _fsa2.seal();
+    _fsa3.seal();
+    _fsa4.seal();
+    _fsa5.seal();
+    _fsa6.seal();
+  }
+
+  // see SmallObjectAllocator::forEachSizeClass
+  template<class F>
+  void forEachSizeClass(F f) const {
+    f(_fsa0.statistics());
+    f(_fsa1.statistics());
+    f(_fsa2.statistics());
+    f(_fsa3.statistics());
+    f(_fsa4.statistics());
+    f(_fsa5.statistics());
+    f(_fsa6.statistics());
+  }
+
+  // see SmallObjectAllocator::compact
+  void compact(bool release) {
+    _fsa0.compact(release);
+    _fsa1.compact(release);
+    _fsa2.compact(release);
+    _fsa3.compact(release);
+    _fsa4.compact(release);
+    _fsa5.compact(release);
+    _fsa6.compact(release);
+  }
+
+private:
+  FixedSizeAllocator<clauseBytes(0)> _fsa0;
+  FixedSizeAllocator<clauseBytes(1)> _fsa1;
+  FixedSizeAllocator<clauseBytes(2)> _fsa2;
+  FixedSizeAllocator<clauseBytes(3)> _fsa3;
+  FixedSizeAllocator<clauseBytes(4)> _fsa4;
+  FixedSizeAllocator<clauseBytes(5)> _fsa5;
+  FixedSizeAllocator<clauseBytes(6)> _fsa6;
+};
+
+static ClauseAllocator clauseAllocator;
+
+static void* allocClause(unsigned length)
+{
+  COUNT_ALLOCATION(Clause, clauseBytes(length))
+  return clauseAllocator.alloc(length);
+}
+
+static void freeClause(void* ptr, unsigned length)
+{
+  COUNT_DEALLOCATION(Clause, clauseBytes(length))
+  clauseAllocator.free(ptr, length);
+}
+
+void Clause::sealAllocator()
+{ clauseAllocator.seal(); }
+
+void Clause::compactAllocator(bool release)
+{ clauseAllocator.compact(release); }
+
+void Clause::printAllocatorStatistics(std::ostream& out)
+{
+  out << "Clause allocator size classes:" << endl;
+  clauseAllocator.forEachSizeClass([&](SizeClassStatistics stats) { out << stats << endl; });
+}
+
+#else // INDIVIDUAL_ALLOCATIONS
+
+static void* allocClause(unsigned length)
+{ return ALLOC_KNOWN(clauseBytes(length),"Kernel::Clause"); }
+
+static void freeClause(void* ptr, unsigned length)
+{ DEALLOC_KNOWN(ptr, clauseBytes(length),"Kernel::Clause"); }
+
+void Clause::sealAllocator() {}
+
+void Clause::compactAllocator(bool release) {}
+
+void Clause::printAllocatorStatistics(std::ostream& out) {}
+
+#endif // INDIVIDUAL_ALLOCATIONS
+
 /**
  * Allocate a clause having lits literals.
  * @since 18/05/2007 Manchester
@@ -105,26 +242,14 @@ void* Clause::operator new(size_t sz, unsigned lits)
 
   RSTAT_CTR_INC("clauses created");
 
-  //We have to get sizeof(Clause) + (_length-1)*sizeof(Literal*)
-  //this way, because _length-1 wouldn't behave well for
-  //_length==0 on x64 platform.
-  size_t size = sizeof(Clause) + lits * sizeof(Literal*);
-  size -= sizeof(Literal*);
-
-  return ALLOC_KNOWN(size,"Clause");
+  return allocClause(lits);
 }
 
 void Clause::operator delete(void* ptr,unsigned length)
 {
   RSTAT_CTR_INC("clauses deleted by delete operator");
 
-  //We have to get sizeof(Clause) + (_length-1)*sizeof(Literal*)
-  //this way, because _length-1 wouldn't behave well for
-  //_length==0 on x64 platform.
-  size_t size = sizeof(Clause) + length * sizeof(Literal*);
-  size -= sizeof(Literal*);
-
-  DEALLOC_KNOWN(ptr, size,"Clause");
+  freeClause(ptr, length);
 }
 
 void Clause::destroyExceptInferenceObject()
@@ -137,13 +262,7 @@ void Clause::destroyExceptInferenceObject()
 
   RSTAT_CTR_INC("clauses deleted");
 
-  //We have to get sizeof(Clause) + (_length-1)*sizeof(Literal*)
-  //this way, because _length-1 wouldn't behave well for
-  //_length==0 on x64 platform.
-  size_t size = sizeof(Clause) + _length * sizeof(Literal*);
-  size -= sizeof(Literal*);
-
-  DEALLOC_KNOWN(this, size,"Clause");
+  freeClause(this, _length);
 }
 
 
@@ -507,6 +626,74 @@ unsigned Clause::computeWeight() const
   return result;
 } // Clause::computeWeight
 
+/**
+ * Return a hash of the clause with literals @b lits that is the same for all its
+ * variants. It depends neither on the names of the variables, nor on the order of
+ * the literals, nor on the order of the arguments of equalities. Variables are
+ * only distinguished by the numbers of their occurrences. Never returns 0.
+ */
+unsigned Clause::variantHash(Literal* const* lits, unsigned length)
+{
+  static DHMap<unsigned, unsigned> varOccs;
+  varOccs.reset();
+
+  const unsigned varHash = 1u;
+  auto countVar = [&](unsigned var) {
+    unsigned* occs;
+    varOccs.getValuePtr(var, occs, 0);
+    (*occs)++;
+  };
+  auto termHash = [&](TermList t) {
+    if (t.isVar()) {
+      countVar(t.var());
+      return varHash;
+    }
+    if (t.term()->ground()) {
+      return DefaultHash::hash(t.term()->getId());
+    }
+    unsigned res = DefaultHash::hash(t.term()->functor());
+    SubtermIterator sit(t.term());
+    while (sit.hasNext()) {
+      TermList st = sit.next();
+      if (st.isVar()) {
+        countVar(st.var());
+        res = DefaultHash::hash(varHash, res);
+      } else {
+        res = DefaultHash::hash(st.term()->functor(), res);
+      }
+    }
+    return res;
+  };
+
+  unsigned res = DefaultHash::hash(length);
+  for (unsigned i = 0; i < length; i++) {
+    Literal* lit = lits[i];
+    unsigned litHash;
+    if (lit->ground()) {
+      litHash = DefaultHash::hash(lit->getId());
+    } else if (lit->isEquality()) {
+      // the sum does not depend on the order of the arguments
+      litHash = DefaultHash::hash(termHash(*lit->nthArgument(0)) + termHash(*lit->nthArgument(1)), lit->header());
+    } else {
+      litHash = DefaultHash::hash(lit->header());
+      for (unsigned j = 0; j < lit->arity(); j++) {
+        litHash = HashUtils::combine(litHash, termHash(*lit->nthArgument(j)));
+      }
+    }
+    // the sum does not depend on the order of the literals
+    res += litHash;
+  }
+
+  if (varOccs.size() > 1) {
+    static Stack<unsigned> histogram;
+    histogram.reset();
+    histogram.loadFromIterator(DHMap<unsigned, unsigned>::Iterator(varOccs));
+    std::sort(histogram.begin(), histogram.end());
+    res = DefaultHash::hash(histogram, res);
+  }
+  return res ? res : 1;
+}
+
 
 /**
  * Return weight of the split part of the clause
@@ -89,6 +89,12 @@ private:
   void* operator new(size_t,unsigned length);
 public:
   void operator delete(void* ptr,unsigned length);
+  /** Stop recycling the memory of the clauses allocated so far, see Lib::sealAllocations */
+  static void sealAllocator();
+  /** Defragment the memory of deleted clauses, see Lib::compactAllocations */
+  static void compactAllocator(bool release);
+  /** Print the occupancy of the size classes of the clause allocator */
+  static void printAllocatorStatistics(std::ostream& out);
 
   static Clause* fromArray(Literal*const* lits, unsigned size, Inference inf)
   { return new(size) Clause(lits, size, std::move(inf)); }
@@ -186,6 +192,16 @@ public:
   }
   unsigned computeWeight() const;
 
+  /** Return a hash of the clause that is the same for all its variants, see variantHash(Literal* const*, unsigned) */
+  unsigned variantHash() const
+  {
+    if(!_variantHash) {
+      _variantHash = variantHash(_literals, _length);
+    }
+    return _variantHash;
+  }
+  static unsigned variantHash(Literal* const* lits, unsigned length);
+
   /**
    * weight used for clause selection
    */
@@ -231,6 +247,8 @@ public:
   bool shouldBeDestroyed();
   void destroyIfUnnecessary();
 
+  /** Return the number of references to this clause */
+  unsigned refCnt() const { return _refCnt; }
   void incRefCnt() { _refCnt++; }
   void decRefCnt()
   {
@@ -411,6 +429,8 @@ protected:
   InverseLookup<Literal>* _literalPositions;
 
   int _numActiveSplits;
+  /** hash of the clause modulo variants, or 0 if not computed yet */
+  mutable unsigned _variantHash;
 
   size_t _auxTimestamp;
   void* _auxData;
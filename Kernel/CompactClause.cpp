@@ -0,0 +1,140 @@
+/*
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ */
+/**
+ * @file CompactClause.cpp
+ * Implements class CompactClause.
+ */
+
+#include <cstring>
+
+#include "Lib/Allocator.hpp"
+
+#include "Clause.hpp"
+
+#include "CompactClause.hpp"
+
+namespace Kernel
+{
+
+using namespace Lib;
+
+/**
+ * The number of bytes taken by a compact clause with @b length literals.
+ */
+static constexpr size_t compactClauseBytes(unsigned length)
+{
+  // one literal is already accounted for in the size of the object
+  return sizeof(CompactClause) + length * sizeof(Literal*) - sizeof(Literal*);
+}
+
+void* CompactClause::operator new(size_t sz, unsigned length)
+{
+  ASS_EQ(sz, sizeof(CompactClause));
+
+  return ALLOC_KNOWN(compactClauseBytes(length), "Kernel::CompactClause");
+}
+
+void CompactClause::operator delete(void* ptr, unsigned length)
+{
+  DEALLOC_KNOWN(ptr, compactClauseBytes(length), "Kernel::CompactClause");
+}
+
+/**
+ * Free the memory of the compact clause without releasing its parents,
+ * as when its bytes have been copied elsewhere, see fromBytes().
+ */
+void CompactClause::deallocate()
+{
+  DEALLOC_KNOWN(this, compactClauseBytes(_length), "Kernel::CompactClause");
+}
+
+/** Return the number of bytes taken by the compact clause */
+size_t CompactClause::bytes() const
+{
+  return compactClauseBytes(_length);
+}
+
+/**
+ * Create the compact clause from a copy of its @b bytes(), which were taken
+ * over together with the references to the parents
+ */
+CompactClause* CompactClause::fromBytes(const void* data)
+{
+  unsigned length = static_cast<const CompactClause*>(data)->_length;
+  void* mem = operator new(sizeof(CompactClause), length);
+  std::memcpy(mem, data, compactClauseBytes(length));
+  return static_cast<CompactClause*>(mem);
+}
+
+CompactClause::CompactClause(Clause* cl, const Shell::Options& opt)
+  : _inference(cl->inference()),
+    _number(cl->number()),
+    _length(cl->length()),
+    _weight(cl->weight()),
+    _weightForClauseSelection(cl->weightForClauseSelection(opt))
+{
+  for (unsigned i = 0; i < _length; i++) {
+    _literals[i] = (*cl)[i];
+  }
+}
+
+/**
+ * True if @b cl can be replaced by its compact form.
+ *
+ * Nothing may refer to the clause, as the clause object gets destroyed: it must not
+ * have any references other than the @b ownReferences, which the caller holds without
+ * pointing to the clause from anywhere, and it must not have splits, as the splitter keeps
+ * track of the clauses depending on splits. The clauses from preprocessing are kept in
+ * the problem, and the tag of the extensionality axioms would be lost.
+ */
+bool CompactClause::canCompact(Clause* cl, unsigned ownReferences)
+{
+  return cl->refCnt() == ownReferences && cl->noSplits() && !cl->isFromPreprocessing() && !cl->isTaggedExtensionality();
+}
+
+/**
+ * Replace @b cl by its compact form, the clause object is destroyed
+ * together with the caller's @b ownReferences to it.
+ */
+CompactClause* CompactClause::fromClause(Clause* cl, const Shell::Options& opt, unsigned ownReferences)
+{
+  ASS(canCompact(cl, ownReferences));
+
+  CompactClause* res = new(cl->length()) CompactClause(cl, opt);
+  // the references to the parents now belong to the compact clause
+  cl->destroyExceptInferenceObject();
+  return res;
+}
+
+/**
+ * Construct the clause again, with its original number, and destroy the compact clause.
+ * The store of the clause is NONE.
+ */
+Clause* CompactClause::materialize()
+{
+  Clause* res = Clause::fromArray(_literals, _length, _inference);
+  // the clause keeps its old number, so it must not use up a new one
+  Unit::releaseNumber(res);
+  res->overwriteNumber(_number);
+  deallocate();
+  return res;
+}
+
+/**
+ * Destroy the compact clause of a clause that will not be needed,
+ * which releases its parents.
+ */
+void CompactClause::destroy()
+{
+  _inference.destroy();
+  deallocate();
+}
+
+}
@@ -0,0 +1,90 @@
+/*
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ */
+/**
+ * @file CompactClause.hpp
+ * Defines class CompactClause.
+ */
+
+#ifndef __CompactClause__
+#define __CompactClause__
+
+#include "Forwards.hpp"
+
+#include "Debug/Assertion.hpp"
+
+#include "Inference.hpp"
+
+namespace Kernel {
+
+/**
+ * A compact form of a passive clause, which is kept instead of the clause
+ * until the clause gets selected.
+ *
+ * It keeps only what the passive queues order the clauses by and what is needed
+ * to construct the clause again: the number, the weights, the inference (that is
+ * the references to the parents, the rule, the age and the splits) and the literals.
+ * The literals are shared, they stay in the term sharing structure in any case,
+ * so they are kept by their pointers.
+ *
+ * The clause must not be referred to from anywhere else while it is compact:
+ * see canCompact().
+ */
+class CompactClause
+{
+public:
+  static bool canCompact(Clause* cl, unsigned ownReferences = 0);
+  static CompactClause* fromClause(Clause* cl, const Shell::Options& opt, unsigned ownReferences = 0);
+
+  Clause* materialize();
+  void destroy();
+
+  size_t bytes() const;
+  static CompactClause* fromBytes(const void* data);
+  void deallocate();
+
+  /** Return the number of the clause */
+  unsigned number() const { return _number; }
+  /** Return the inference of the clause */
+  const Inference& inference() const { return _inference; }
+  /** Return the age of the clause */
+  unsigned age() const { return _inference.age(); }
+  /** Return the input type of the clause */
+  UnitInputType inputType() const { return _inference.inputType(); }
+  /** Return the number of literals */
+  unsigned length() const { return _length; }
+  /** Return the weight of the clause */
+  unsigned weight() const { return _weight; }
+  /** Return the weight of the clause used for clause selection */
+  unsigned weightForClauseSelection(const Shell::Options&) const { return _weightForClauseSelection; }
+
+  /** Return the @b n-th literal */
+  Literal* operator[](unsigned n) const
+  {
+    ASS_L(n, _length);
+    return _literals[n];
+  }
+
+private:
+  CompactClause(Clause* cl, const Shell::Options& opt);
+  void* operator new(size_t sz, unsigned length);
+  void operator delete(void* ptr, unsigned length);
+
+  Inference _inference;
+  unsigned _number;
+  unsigned _length;
+  unsigned _weight;
+  unsigned _weightForClauseSelection;
+  /** the literals, the array continues past the object */
+  Literal* _literals[1];
+}; // class CompactClause
+
+}
+
+#endif // __CompactClause__
@@ -42,7 +42,7 @@ void* FlatTerm::operator new(size_t sz,unsigned num)
     size += (num-1)*sizeof(Entry);
   }
 
-  return ALLOC_KNOWN(size,"FlatTerm");
+  return ALLOC_KNOWN(size,"Kernel::FlatTerm");
 }
 
 /**
@@ -58,7 +58,7 @@ void FlatTerm::destroy()
     size += (_length-1)*sizeof(Entry);
   }
 
-  DEALLOC_KNOWN(this, size,"FlatTerm");
+  DEALLOC_KNOWN(this, size,"Kernel::FlatTerm");
 }
 
 FlatTerm::FlatTerm(size_t length)
@@ -457,6 +457,8 @@ enum class InferenceRule : unsigned char {
 
   /** inference coming from outside of Vampire */
   EXTERNAL,
+  /** lemma derived by another worker of the portfolio mode */
+  IMPORTED_LEMMA,
 
   /* FMB flattening */
   FMB_FLATTENING,
@@ -50,7 +50,7 @@ public:
       size_t size=sizeof(FullInference)+premCnt*sizeof(Unit*);
       size-=sizeof(Unit*);
 
-      return ALLOC_KNOWN(size,"InferenceStore::FullInference");
+      return ALLOC_KNOWN(size,"Kernel::InferenceStore::FullInference");
     }
 
     size_t occupiedBytes()
@@ -763,7 +763,7 @@ Ordering::Result KBO::comparePredicates(Literal* l1, Literal* l2) const
 
 Ordering::Result KBO::compare(TermList tl1, TermList tl2) const
 {
-  return compare(AppliedTerm(tl1),AppliedTerm(tl2));
+  return compareCached(tl1, tl2, [&]() { return compare(AppliedTerm(tl1),AppliedTerm(tl2)); });
 }
 
 Ordering::Result KBO::compare(AppliedTerm tl1, AppliedTerm tl2) const
@@ -784,6 +784,23 @@ Ordering::Result KBO::compare(AppliedTerm tl1, AppliedTerm tl2) const
   Term* t1=tl1.term.term();
   Term* t2=tl2.term.term();
 
+  if(!tl1.aboveVar && !tl2.aboveVar && t1->shared() && t2->shared()) {
+    // A term can only be greater than or equal to another one if it has every
+    // variable of the other one at least as many times. When the stored variable
+    // summaries rule this out in a direction, only the other direction is checked.
+    bool notGreater = (t2->varMask() & ~t1->varMask()) || t2->numVarOccs() > t1->numVarOccs();
+    bool notLess = (t1->varMask() & ~t2->varMask()) || t1->numVarOccs() > t2->numVarOccs();
+    if(notGreater && notLess) {
+      return INCOMPARABLE;
+    }
+    if(notGreater) {
+      return compareUnidirectional(tl2, tl1) == GREATER ? LESS : INCOMPARABLE;
+    }
+    if(notLess) {
+      return compareUnidirectional(tl1, tl2) == GREATER ? GREATER : INCOMPARABLE;
+    }
+  }
+
   ASS(_state);
   State* state = _state.get();
 #if VDEBUG
@@ -66,7 +66,7 @@ Ordering::Result LPO::comparePredicates(Literal* l1, Literal *l2) const
 
 Ordering::Result LPO::compare(TermList tl1, TermList tl2) const
 {
-  return compare(AppliedTerm(tl1),AppliedTerm(tl2));
+  return compareCached(tl1, tl2, [&]() { return compare(AppliedTerm(tl1),AppliedTerm(tl2)); });
 }
 
 Ordering::Result LPO::compare(AppliedTerm tl1, AppliedTerm tl2) const
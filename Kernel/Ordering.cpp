@@ -32,6 +32,7 @@
 #include "Shell/Options.hpp"
 #include "Shell/Property.hpp"
 #include "Shell/Shuffling.hpp"
+#include "Shell/Statistics.hpp"
 
 #include "LPO.hpp"
 #include "KBO.hpp"
@@ -669,6 +670,58 @@ static void loadPermutationFromString(DArray<unsigned>& p, const std::string& st
   }
 }
 
+/**
+ * Make the cache have @b size slots, rounded up to a power of two,
+ * or none if @b size is zero.
+ */
+void OrderingResultCache::init(unsigned size)
+{
+  if (!size) {
+    return;
+  }
+  unsigned slots = 1;
+  while (slots < size) {
+    slots *= 2;
+  }
+  _entries.init(slots, Entry());
+}
+
+/**
+ * If the result of comparing @b t1 with @b t2 is in the cache,
+ * assign it to @b res and return true, otherwise return false.
+ */
+bool OrderingResultCache::find(Term* t1, Term* t2, Ordering::Result& res)
+{
+  bool swapped = t2 < t1;
+  if (swapped) {
+    std::swap(t1, t2);
+  }
+  Entry& e = entry(t1, t2);
+  if (e.t1 != t1 || e.t2 != t2) {
+    env.statistics->orderingCacheMisses++;
+    return false;
+  }
+  env.statistics->orderingCacheHits++;
+  res = swapped ? Ordering::reverse(e.res) : e.res;
+  return true;
+}
+
+/**
+ * Store @b res as the result of comparing @b t1 with @b t2,
+ * in place of the pair in its slot.
+ */
+void OrderingResultCache::insert(Term* t1, Term* t2, Ordering::Result res)
+{
+  if (t2 < t1) {
+    std::swap(t1, t2);
+    res = Ordering::reverse(res);
+  }
+  Entry& e = entry(t1, t2);
+  e.t1 = t1;
+  e.t2 = t2;
+  e.res = res;
+}
+
 bool isPermutation(const DArray<int>& xs) {
   DArray<int> cnts(xs.size()); 
   cnts.init(xs.size(), 0);
@@ -723,6 +776,7 @@ PrecedenceOrdering::PrecedenceOrdering(Problem& prb, const Options& opt, const D
     qkboPrecedence
     )
 {
+  _resultCache.init(opt.orderingCache());
 }
 
 /**
@@ -24,6 +24,7 @@
 #include "Lib/Comparison.hpp"
 #include "Lib/SmartPtr.hpp"
 #include "Lib/DArray.hpp"
+#include "Lib/Hash.hpp"
 #include "Kernel/Term.hpp"
 
 #include "Lib/Allocator.hpp"
@@ -163,6 +164,38 @@ private:
   static OrderingSP s_globalOrdering;
 }; // class Ordering
 
+/**
+ * A bounded cache of the results of comparing pairs of shared terms.
+ *
+ * It is direct-mapped: a pair has a single slot given by the ids of the terms,
+ * and a new result replaces whatever pair was there before. A pair is stored
+ * once for both of its orders. Shared terms are never destroyed, so a term
+ * pointer identifies the same term for the whole run.
+ */
+class OrderingResultCache
+{
+public:
+  void init(unsigned size);
+  /** True if the cache has any slots */
+  bool enabled() const { return _entries.size(); }
+  bool find(Term* t1, Term* t2, Ordering::Result& res);
+  void insert(Term* t1, Term* t2, Ordering::Result res);
+
+private:
+  struct Entry
+  {
+    Term* t1 = nullptr;
+    Term* t2 = nullptr;
+    Ordering::Result res = Ordering::EQUAL;
+  };
+
+  Entry& entry(Term* t1, Term* t2)
+  { return _entries[HashUtils::combine(t1->getId(), t2->getId()) & (_entries.size() - 1)]; }
+
+  /** the slots, their number is a power of two */
+  DArray<Entry> _entries;
+};
+
 // orderings that rely on symbol precedence
 class PrecedenceOrdering
 : public Ordering
@@ -197,6 +230,26 @@ protected:
   static DArray<int> typeConPrecFromOpts(Problem& prb, const Options& opt);
   static DArray<int> predLevelsFromOptsAndPrec(Problem& prb, const Options& opt, const DArray<int>& predicatePrecedences);
 
+  /**
+   * Return the result of comparing the terms @b tl1 and @b tl2, which @b compare computes.
+   * If both are shared terms, the result is taken from the result cache when it is there,
+   * and put there otherwise.
+   */
+  template<class Compare>
+  Result compareCached(TermList tl1, TermList tl2, Compare compare) const
+  {
+    if (!_resultCache.enabled() || tl1 == tl2 || !tl1.isTerm() || !tl2.isTerm() ||
+        !tl1.term()->shared() || !tl2.term()->shared()) {
+      return compare();
+    }
+    Result res;
+    if (!_resultCache.find(tl1.term(), tl2.term(), res)) {
+      res = compare();
+      _resultCache.insert(tl1.term(), tl2.term(), res);
+    }
+    return res;
+  }
+
   Result comparePrecedences(const Term* t1, const Term* t2) const;
 
   Result compareFunctionPrecedences(unsigned fun1, unsigned fun2) const;
@@ -221,6 +274,8 @@ protected:
 
   bool _reverseLCM;
   bool _qkboPrecedence;
+  /** the results of comparing shared terms, see ordering_cache */
+  mutable OrderingResultCache _resultCache;
 };
 
 
@@ -53,7 +53,7 @@ void* Term::operator new(size_t,unsigned arity, size_t preData)
   ASS_EQ(preData%sizeof(size_t), 0);
 
   size_t sz = sizeof(Term)+arity*sizeof(TermList)+preData;
-  void* mem = ALLOC_KNOWN(sz,"Term");
+  void* mem = ALLOC_KNOWN(sz,"Kernel::Term");
   mem = reinterpret_cast<void*>(reinterpret_cast<char*>(mem)+preData);
   return (Term*)mem;
 } // Term::operator new
@@ -74,7 +74,7 @@ void Term::destroy ()
   size_t sz = sizeof(Term)+_arity*sizeof(TermList)+getPreDataSize();
   void* mem = this;
   mem = reinterpret_cast<void*>(reinterpret_cast<char*>(mem)-getPreDataSize());
-  DEALLOC_KNOWN(mem,sz,"Term");
+  DEALLOC_KNOWN(mem,sz,"Kernel::Term");
 } // Term::destroy
 
 /**
@@ -1591,6 +1591,7 @@ Term::Term(const Term& t) throw()
 #if VDEBUG
     _kboInstance(nullptr),
 #endif
+    _varMask(0),
     _vars(0)
 {
   ASS(!isSpecial()); //we do not copy special terms
@@ -1626,6 +1627,7 @@ Term::Term() throw()
    _kboInstance(nullptr),
 #endif
    _maxRedLen(0),
+   _varMask(0),
    _vars(0)
 {
   _args[0].setContent(0);
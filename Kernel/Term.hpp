@@ -742,6 +742,26 @@ public:
     _maxRedLen = rl;
   } // setWeight
 
+  /**
+   * Return a summary of the variables of a shared term: bit v mod 32 is set for
+   * every variable v occurring in it. So if a bit is set in the mask of one term
+   * and not in that of another, the former term has a variable the latter does not.
+   */
+  unsigned varMask() const
+  {
+    ASS(shared() && !isLiteral());
+    return _varMask;
+  }
+
+  void setVarMask(unsigned mask)
+  {
+    _varMask = mask;
+  }
+
+  /** Return the variable mask bit of the variable @b var, see varMask() */
+  static unsigned varMaskBit(unsigned var)
+  { return 1u << (var % 32); }
+
   /** Set the number of variable _occurrences_ */
   void setNumVarOccs(unsigned v)
   {
@@ -936,6 +956,8 @@ protected:
 #endif
   /** length of maximum reduction length */
   int _maxRedLen;
+  /** Bit v mod 32 is set for every variable v occurring in the term */
+  unsigned _varMask;
   union {
     /** If _isTwoVarEquality is false, this value is valid and contains
      * number of occurrences of variables */
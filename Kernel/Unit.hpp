@@ -62,6 +62,8 @@ public:
   unsigned number() const { return _number; }
   /** Forcefully change the unit's number - use with care! - numbers should be unique across the whole board! */
   void overwriteNumber(unsigned newNumber) { _number = newNumber; }
+  /** Give back the number of @b u, the last unit created, whose number is about to be overwritten */
+  static void releaseNumber(Unit* u) { ASS_EQ(u->_number, _lastNumber); _lastNumber--; }
 
   /** Return the inference of this unit */
   Inference& inference() { return _inference; }
@@ -16,13 +16,32 @@
  * @since 24/07/2023, mostly replaced by a small-object allocator
  */
 
+#include <algorithm>
 #include <cstdio>
 #include <cerrno>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
 
 #include "Allocator.hpp"
 
 #ifndef INDIVIDUAL_ALLOCATIONS
 Lib::SmallObjectAllocator Lib::GLOBAL_SMALL_OBJECT_ALLOCATOR;
+
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+void Lib::compactAllocations(bool release) {
+  GLOBAL_SMALL_OBJECT_ALLOCATOR.compact(release);
+#ifdef __GLIBC__
+  // released blocks (ours and those of the other fixed-size allocators) only go back to the system allocator's heap,
+  // let it hand the whole free pages back to the system (by madvise)
+  if(release)
+    malloc_trim(0);
+#endif
+}
 #endif
 
 #if __has_include(<sys/resource.h>)
@@ -66,3 +85,77 @@ long Lib::peakMemoryUsageKB() {
 
   return 0;
 }
+
+std::ostream &Lib::operator<<(std::ostream &out, const SizeClassStatistics &stats) {
+  return out << "  " << stats.size << " bytes: "
+    << stats.blocks << " blocks, "
+    << stats.live << " live chunks, "
+    << stats.free << " free chunks ("
+    << (stats.free * stats.size >> 10) << " KB)";
+}
+
+#if VALLOCATION_STATISTICS
+std::string Lib::AllocationCounter::name() const {
+  if(!_signature)
+    return _label;
+  // the signature ends in "[with C = <type>]" (GCC) or "[C = <type>]" (Clang)
+  std::string signature = _signature;
+  size_t start = signature.find("C = ");
+  if(start == std::string::npos)
+    return signature;
+
+  // drop the template arguments, so that all the instances of a template are one kind
+  std::string name;
+  unsigned depth = 0;
+  for(size_t i = start + 4; i < signature.size(); i++) {
+    char c = signature[i];
+    if(c == '<')
+      depth++;
+    else if(c == '>')
+      depth--;
+    else if(!depth && (c == ']' || c == ';'))
+      break;
+    else if(!depth)
+      name += c;
+  }
+  return name;
+}
+
+void Lib::AllocationCounter::printAll(std::ostream &out) {
+  struct Total {
+    long long bytes = 0;
+    size_t allocations = 0;
+    size_t deallocations = 0;
+  };
+  // NB allocating here may add counters to the list, but only at its front
+  std::map<std::string, Total> totals;
+  for(AllocationCounter *c = s_first; c; c = c->_next) {
+    Total &total = totals[c->name()];
+    total.bytes += c->_bytes;
+    total.allocations += c->_allocations;
+    total.deallocations += c->_deallocations;
+  }
+
+  std::vector<std::pair<std::string, Total>> sorted(totals.begin(), totals.end());
+  std::sort(sorted.begin(), sorted.end(), [](const auto &l, const auto &r) { return l.second.bytes > r.second.bytes; });
+  for(const auto &[name, total] : sorted) {
+    if(!total.allocations)
+      continue;
+    out << "  " << name << ": " << (total.bytes >> 10) << " KB in use, "
+      << total.allocations << " allocations, " << total.deallocations << " deallocations" << std::endl;
+  }
+}
+#endif
+
+void Lib::printAllocationStatistics(std::ostream &out) {
+#ifndef INDIVIDUAL_ALLOCATIONS
+  out << "Small-object allocator size classes:" << std::endl;
+  GLOBAL_SMALL_OBJECT_ALLOCATOR.forEachSizeClass([&](SizeClassStatistics stats) { out << stats << std::endl; });
+#endif
+#if VALLOCATION_STATISTICS
+  out << "Memory in use by kind of object:" << std::endl;
+  AllocationCounter::printAll(out);
+#else
+  out << "(build with ALLOCATION_STATISTICS for the memory in use by kind of object)" << std::endl;
+#endif
+}
@@ -21,8 +21,13 @@
 #define __Allocator__
 
 #include <cstddef>
+#include <iosfwd>
 #include <new>
 
+#if VALLOCATION_STATISTICS
+#include <string>
+#endif
+
 #include "Debug/Assertion.hpp"
 
 /*
@@ -36,6 +41,84 @@ namespace Lib {
 // attempt to set a memory limit for this process by system call
 void setMemoryLimit(size_t bytes);
 long peakMemoryUsageKB();
+
+#if VALLOCATION_STATISTICS
+/*
+ * The memory in use by one kind of object, for the memory statistics
+ * (only counted in builds with ALLOCATION_STATISTICS, as it costs a little on every allocation).
+ *
+ * A kind of object is named after its type, qualified and without template arguments (e.g. "Lib::Stack"):
+ * USE_ALLOCATOR classes get the name of their type, see `AllocationCounter::of`, and the sites of `ALLOC_KNOWN`
+ * and `DEALLOC_KNOWN` label their blocks with the name of the type that owns them, so both are reported together.
+ * Counters join the list of all counters when first used, and the report sums up the counters of the same name.
+ * Counters are constant-initialised, so they are safe to use during static initialisation.
+ */
+class AllocationCounter {
+public:
+  // the counter of the kind named by the string literal `label`, or by the type in the signature `of<C>`
+  constexpr AllocationCounter(const char *label, const char *signature) : _label(label), _signature(signature) {}
+
+  // the counter shared by all the objects of type `C`, named after the type without its template arguments
+  // (taken from the signature of this function, as we build without RTTI)
+  template<class C>
+  static AllocationCounter &of() {
+    static AllocationCounter counter(nullptr, __PRETTY_FUNCTION__);
+    return counter;
+  }
+
+  void allocated(size_t bytes) {
+    list();
+    _bytes += bytes;
+    _allocations++;
+  }
+
+  void deallocated(size_t bytes) {
+    list();
+    _bytes -= bytes;
+    _deallocations++;
+  }
+
+  // print the memory in use by each kind of object, largest first
+  static void printAll(std::ostream &out);
+
+private:
+  void list() {
+    if(!_listed) {
+      _listed = true;
+      _next = s_first;
+      s_first = this;
+    }
+  }
+
+  std::string name() const;
+
+  const char *_label;
+  const char *_signature;
+  // may go below zero: deallocation sites only subtract
+  long long _bytes = 0;
+  size_t _allocations = 0;
+  size_t _deallocations = 0;
+  bool _listed = false;
+  AllocationCounter *_next = nullptr;
+
+  inline static AllocationCounter *s_first = nullptr;
+};
+#endif // VALLOCATION_STATISTICS
+
+// occupancy of one size class of an allocator, for the memory statistics
+struct SizeClassStatistics {
+  size_t size;
+  // blocks obtained from the system (and not released)
+  size_t blocks;
+  // chunks handed out and not freed
+  size_t live;
+  // chunks in the free list
+  size_t free;
+};
+std::ostream &operator<<(std::ostream &out, const SizeClassStatistics &stats);
+
+// print the statistics of the global small-object allocator and of the memory use by kind of object
+void printAllocationStatistics(std::ostream &out);
 }
 
 #ifdef INDIVIDUAL_ALLOCATIONS
@@ -47,6 +130,9 @@ inline void *alloc(size_t size, size_t align = alignof(std::max_align_t)) {
 inline void free(void *pointer, size_t size, size_t align = alignof(std::max_align_t)) {
   ::operator delete(pointer, (std::align_val_t)align);
 }
+
+inline void sealAllocations() {}
+inline void compactAllocations(bool release) {}
 } // namespace Lib
 #define USE_GLOBAL_SMALL_OBJECT_ALLOCATOR(C)
 
@@ -61,16 +147,20 @@ namespace Lib {
  * chopping it into smaller fixed-size chunks for fast allocation/deallocation.
  * Chunks are `SIZE` bytes long, aligned to the greatest common divisor of `SIZE` and `alignof(std::max_align_t)`.
  *
- * The allocator never releases memory to the system, instead retaining it in a free list for reallocation.
+ * The allocator retains freed memory in a free list for reallocation.
  * This fits Vampire's generally-growing allocation pattern reasonably well in practice.
+ * For long runs with a lot of deletion, `compact` can order the free list and give empty blocks back.
  */
 template<size_t SIZE>
 class FixedSizeAllocator {
   // number of chunks (of size `SIZE`) to allocate at a time from the system
   static const size_t COUNT = 1024;
+  // room at the start of each block to link it into `blocks`, keeping the chunks maximally aligned
+  static const size_t HEADER = alignof(std::max_align_t);
 
   // to allow for a sneaky implementation hack, we cannot allocate anything smaller than sizeof(void *)
   static_assert(SIZE >= sizeof(void *), "need to store void * in the allocation to keep the free list");
+  static_assert(HEADER >= sizeof(void *), "need to store void * in the block header");
 
   // An allocated block of memory from the system
   struct Block {
@@ -96,8 +186,13 @@ class FixedSizeAllocator {
     }
   };
 
-  // the current block - old blocks are leaked
+  // the current block
   Block current;
+  // all the blocks obtained from the system, linked through their headers
+  void **blocks = nullptr;
+  size_t block_count = 0;
+  // chunks never to be carved out of sealed blocks
+  size_t abandoned = 0;
   /*
    * The free list.
    *
@@ -106,6 +201,36 @@ class FixedSizeAllocator {
    * while `*ptr` points to the previous value of `free_list`.
    */
   void **free_list = nullptr;
+  // length of the free list
+  size_t free_count = 0;
+
+  /*
+   * Merge sort the first `n` elements of the list `*list`, linked through their first word, by address.
+   * Advances `*list` past them and returns the sorted list.
+   * Works in place, so that it can run when memory is tight.
+   */
+  static void **sortByAddress(void ***list, size_t n) {
+    ASS_G(n, 0)
+    if(n == 1) {
+      void **head = *list;
+      *list = static_cast<void **>(*head);
+      *head = nullptr;
+      return head;
+    }
+    void **left = sortByAddress(list, n / 2);
+    void **right = sortByAddress(list, n - n / 2);
+
+    void *merged = nullptr;
+    void **last = &merged;
+    while(left && right) {
+      void ***smaller = left < right ? &left : &right;
+      *last = *smaller;
+      last = *smaller;
+      *smaller = static_cast<void **>(**smaller);
+    }
+    *last = left ? left : right;
+    return static_cast<void **>(merged);
+  }
 
 public:
   // allocate a single chunk
@@ -114,6 +239,7 @@ public:
     if(free_list) {
       void *recycled = free_list;
       free_list = static_cast<void **>(*free_list);
+      free_count--;
       return recycled;
     }
 
@@ -122,7 +248,11 @@ public:
       return current.alloc();
 
     // current block full, get a new one
-    current.bytes = static_cast<char *>(::operator new(COUNT * SIZE));
+    void **block = static_cast<void **>(::operator new(HEADER + COUNT * SIZE));
+    *block = blocks;
+    blocks = block;
+    block_count++;
+    current.bytes = reinterpret_cast<char *>(block) + HEADER;
     current.remaining = COUNT * SIZE;
     return current.alloc();
   }
@@ -133,6 +263,90 @@ public:
     void **head = static_cast<void **>(ptr);
     *head = free_list;
     free_list = head;
+    free_count++;
+  }
+
+  // forget the current block and the free list, so that future allocations come from fresh blocks
+  // NB chunks allocated so far can still be freed, and then they will be reused
+  void seal() {
+    abandoned += current.remaining / SIZE;
+    current = Block();
+    free_list = nullptr;
+    free_count = 0;
+  }
+
+  SizeClassStatistics statistics() const {
+    // NB the chunks in the free list when sealing are neither live nor free any more, but we don't know where they are
+    size_t carved = block_count * COUNT - abandoned - current.remaining / SIZE;
+    return { SIZE, block_count, carved >= free_count ? carved - free_count : 0, free_count };
+  }
+
+  /*
+   * Defragment the free memory.
+   *
+   * The free list is sorted by address, so that allocation proceeds from the lowest addresses:
+   * new chunks fill the gaps in the older blocks, and the newer blocks are left to empty out.
+   * If `release`, blocks in which every chunk is free are then given back to the system.
+   *
+   * Takes time linear-logarithmic in the length of the free list, to be called occasionally.
+   * Returns the number of blocks released.
+   */
+  size_t compact(bool release) {
+    if(free_count) {
+      void **list = free_list;
+      free_list = sortByAddress(&list, free_count);
+    }
+    if(!release || free_count < COUNT)
+      return 0;
+
+    void **list = blocks;
+    blocks = sortByAddress(&list, block_count);
+
+    // walk the blocks and the free list side by side, unlinking the blocks with COUNT free chunks
+    void *keptBlocks = nullptr;
+    void **lastBlock = &keptBlocks;
+    void *keptFree = nullptr;
+    void **lastFree = &keptFree;
+    void **chunk = free_list;
+    size_t released = 0;
+    for(void **block = blocks; block;) {
+      void **nextBlock = static_cast<void **>(*block);
+      char *start = reinterpret_cast<char *>(block) + HEADER;
+      char *end = start + COUNT * SIZE;
+      ASS(!chunk || reinterpret_cast<char *>(chunk) >= start)
+
+      void **first = chunk;
+      void **lastInBlock = nullptr;
+      size_t free = 0;
+      while(chunk && reinterpret_cast<char *>(chunk) < end) {
+        lastInBlock = chunk;
+        chunk = static_cast<void **>(*chunk);
+        free++;
+      }
+
+      if(free == COUNT) {
+        ::operator delete(block);
+        released++;
+      }
+      else {
+        *lastBlock = block;
+        lastBlock = block;
+        if(free) {
+          *lastFree = first;
+          lastFree = lastInBlock;
+        }
+      }
+      block = nextBlock;
+    }
+    ASS(!chunk)
+    *lastBlock = nullptr;
+    *lastFree = nullptr;
+
+    blocks = static_cast<void **>(keptBlocks);
+    free_list = static_cast<void **>(keptFree);
+    block_count -= released;
+    free_count -= released * COUNT;
+    return released;
   }
 };
 
@@ -211,6 +425,45 @@ public:
     ::operator delete(pointer, (std::align_val_t)align);
   }
 
+  /*
+   * Stop handing out the memory that is free in the blocks allocated so far.
+   *
+   * Useful right after fork(): the pages allocated before are shared copy-on-write with the parent,
+   * and recycling chunks from them would duplicate the pages one write at a time.
+   * Fresh blocks keep the child's writes to pages of its own instead.
+   * The memory lost this way is bounded by the (already shared) free memory of the parent.
+   * Chunks that the child frees later are recycled as usual.
+   */
+  void seal() {
+    FSA1.seal();
+    FSA2.seal();
+    FSA3.seal();
+    FSA4.seal();
+    FSA6.seal();
+    FSA8.seal();
+  }
+
+  // call `f` with the statistics of each size class
+  template<class F>
+  void forEachSizeClass(F f) const {
+    f(FSA1.statistics());
+    f(FSA2.statistics());
+    f(FSA3.statistics());
+    f(FSA4.statistics());
+    f(FSA6.statistics());
+    f(FSA8.statistics());
+  }
+
+  // defragment the free memory of all the size classes, see `FixedSizeAllocator::compact`
+  size_t compact(bool release) {
+    return FSA1.compact(release)
+      + FSA2.compact(release)
+      + FSA3.compact(release)
+      + FSA4.compact(release)
+      + FSA6.compact(release)
+      + FSA8.compact(release);
+  }
+
 private:
   // sizes tuned somewhat based on real allocation data, but I don't claim they couldn't be better!
   // when tuning, bear in mind that the larger the gap between sizes, the more memory is wasted
@@ -257,6 +510,17 @@ inline void *alloc(size_t size) {
   return alloc(size, align);
 }
 
+// Stop recycling memory allocated so far by `GLOBAL_SMALL_OBJECT_ALLOCATOR`, see `SmallObjectAllocator::seal`.
+inline void sealAllocations() {
+  GLOBAL_SMALL_OBJECT_ALLOCATOR.seal();
+}
+
+/*
+ * Defragment the memory free in `GLOBAL_SMALL_OBJECT_ALLOCATOR`, see `SmallObjectAllocator::compact`.
+ * If `release`, also give the empty blocks and the free pages of the system allocator back to the system.
+ */
+void compactAllocations(bool release);
+
 // Deallocate a `pointer` to a memory chunk of known `size`, which must be a multiple of `align`.
 // Memory is returned to `GLOBAL_SMALL_OBJECT_ALLOCATOR`.
 inline void free(void *pointer, size_t size, size_t align) {
@@ -276,19 +540,56 @@ inline void free(void *pointer, size_t size) {
 
 } // namespace Lib
 
+#if VALLOCATION_STATISTICS
+#define COUNT_ALLOCATION(C, size) Lib::AllocationCounter::of<C>().allocated(size);
+#define COUNT_DEALLOCATION(C, size) Lib::AllocationCounter::of<C>().deallocated(size);
+#else
+#define COUNT_ALLOCATION(C, size)
+#define COUNT_DEALLOCATION(C, size)
+#endif
+
 // overload class-specific operator new to call the global small-object allocator
 #define USE_GLOBAL_SMALL_OBJECT_ALLOCATOR(C) \
-  void *operator new(size_t size) { return Lib::alloc(size, alignof(C)); }\
-  void *operator new(size_t size, std::align_val_t align) { return Lib::alloc(size, (size_t)align); }\
-  void operator delete(void *ptr, size_t size) { Lib::free(ptr, size, alignof(C)); } \
-  void operator delete(void *ptr, size_t size, std::align_val_t align) { Lib::free(ptr, size, (size_t)align); }
+  void *operator new(size_t size) { \
+    COUNT_ALLOCATION(C, size) \
+    return Lib::alloc(size, alignof(C)); \
+  } \
+  void *operator new(size_t size, std::align_val_t align) { \
+    COUNT_ALLOCATION(C, size) \
+    return Lib::alloc(size, (size_t)align); \
+  } \
+  void operator delete(void *ptr, size_t size) { \
+    COUNT_DEALLOCATION(C, size) \
+    Lib::free(ptr, size, alignof(C)); \
+  } \
+  void operator delete(void *ptr, size_t size, std::align_val_t align) { \
+    COUNT_DEALLOCATION(C, size) \
+    Lib::free(ptr, size, (size_t)align); \
+  }
 
 #endif // INDIVIDUAL_ALLOCATIONS's else
 
 // legacy macros, should be removed eventually
 #define USE_ALLOCATOR(C) USE_GLOBAL_SMALL_OBJECT_ALLOCATOR(C)
+#if VALLOCATION_STATISTICS
+// `className`, a string literal, is only used for the memory statistics
+#define ALLOC_KNOWN(size, className) ([&]() -> void * { \
+    size_t allocationSize = (size); \
+    static Lib::AllocationCounter allocationCounter(className, nullptr); \
+    allocationCounter.allocated(allocationSize); \
+    return Lib::alloc(allocationSize); \
+  }())
+#define DEALLOC_KNOWN(ptr, size, className) ([&]() { \
+    size_t allocationSize = (size); \
+    void *allocationPtr = (ptr); \
+    static Lib::AllocationCounter allocationCounter(className, nullptr); \
+    allocationCounter.deallocated(allocationSize); \
+    Lib::free(allocationPtr, allocationSize); \
+  }())
+#else
 #define ALLOC_KNOWN(size, className) Lib::alloc(size)
 #define DEALLOC_KNOWN(ptr, size, className) Lib::free(ptr, size)
+#endif
 
 // TODO dubious: probably a compiler lint these days?
 /**
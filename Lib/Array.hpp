@@ -44,7 +44,7 @@ public:
     : _capacity(initialCapacity)
   {
     if(initialCapacity) {
-      void* mem = ALLOC_KNOWN(initialCapacity*sizeof(C),"Array<>");
+      void* mem = ALLOC_KNOWN(initialCapacity*sizeof(C),"Lib::Array");
       _array = array_new<C>(mem, initialCapacity);
     } else {
       _array=0;
@@ -70,7 +70,7 @@ public:
    */
   Array (const Array &o) : _capacity(o._capacity) {
     if (o._array) {
-      void* mem = ALLOC_KNOWN(_capacity*sizeof(C),"Array<>");
+      void* mem = ALLOC_KNOWN(_capacity*sizeof(C),"Lib::Array");
       _array = static_cast<C*>(mem);
       for(size_t i=0; i<_capacity; i++) {
         ::new (&_array[i]) C(o._array[i]);
@@ -87,7 +87,7 @@ public:
   inline Array ()
     : _capacity(31)
   {
-    void* mem = ALLOC_KNOWN(sizeof(C)*31,"Array<>");
+    void* mem = ALLOC_KNOWN(sizeof(C)*31,"Lib::Array");
     _array = array_new<C>(mem, 31);
   }
 
@@ -107,7 +107,7 @@ public:
   {
     if(_array) {
       array_delete(_array, _capacity);
-      DEALLOC_KNOWN(_array,_capacity*sizeof(C),"Array<>");
+      DEALLOC_KNOWN(_array,_capacity*sizeof(C),"Lib::Array");
     }
   }
 
@@ -208,7 +208,7 @@ protected:
     }
 
     // allocate new array and copy old array's content to the new place
-    void* mem = ALLOC_KNOWN(sizeof(C)*newCapacity,"Array<>");
+    void* mem = ALLOC_KNOWN(sizeof(C)*newCapacity,"Lib::Array");
     C* newArray = array_new<C>(mem, newCapacity);
     if(_capacity) {
       for (int i = _capacity-1;i >= 0;i--) {
@@ -219,7 +219,7 @@ protected:
     if(_array) {
       // deallocate the old array
       array_delete(_array,_capacity);
-      DEALLOC_KNOWN(_array,_capacity*sizeof(C),"Array<>");
+      DEALLOC_KNOWN(_array,_capacity*sizeof(C),"Lib::Array");
     }
 
     _array = newArray;
@@ -57,7 +57,7 @@ public:
       while(ep!=_data1) {
 	(--ep)->~T();
       }
-      DEALLOC_KNOWN(_data,_capacity*sizeof(T),"BinaryHeap::T");
+      DEALLOC_KNOWN(_data,_capacity*sizeof(T),"Lib::BinaryHeap");
     }
   }
 
@@ -335,7 +335,7 @@ private:
 
     _capacity= _capacity ? _capacity*2 : 4;
 
-    void* mem = ALLOC_KNOWN(_capacity*sizeof(T),"BinaryHeap::T");
+    void* mem = ALLOC_KNOWN(_capacity*sizeof(T),"Lib::BinaryHeap");
     _data = static_cast<T*>(mem);
     _data1 = _data-1;
 
@@ -350,7 +350,7 @@ private:
     }
 
     if(oldData) {
-      DEALLOC_KNOWN(oldData,oldCapacity*sizeof(T),"BinaryHeap::T");
+      DEALLOC_KNOWN(oldData,oldCapacity*sizeof(T),"Lib::BinaryHeap");
     }
   }
 
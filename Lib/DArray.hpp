@@ -54,7 +54,7 @@ public:
     : _size(size), _capacity(size)
   {
     if(size>0) {
-      void* mem = ALLOC_KNOWN(sizeof(C)*_capacity,"DArray<>");
+      void* mem = ALLOC_KNOWN(sizeof(C)*_capacity,"Lib::DArray");
       _array = array_new<C>(mem, _capacity);
     } else {
       _array=0;
@@ -68,7 +68,7 @@ public:
       _array=0;
       return;
     }
-    void* mem = ALLOC_KNOWN(sizeof(C)*_capacity,"DArray<>");
+    void* mem = ALLOC_KNOWN(sizeof(C)*_capacity,"Lib::DArray");
     _array = static_cast<C*>(mem);
     for(size_t i=0; i<_size; i++) {
       ::new (&_array[i]) C(o[i]);
@@ -93,7 +93,7 @@ public:
   {
     if(_array) {
       array_delete(_array, _capacity);
-      DEALLOC_KNOWN(_array,sizeof(C)*_capacity,"DArray<>");
+      DEALLOC_KNOWN(_array,sizeof(C)*_capacity,"Lib::DArray");
     }
   }
 
@@ -158,12 +158,12 @@ public:
 
     size_t newCapacity = std::max(s, _capacity*2);
 
-    void* mem = ALLOC_KNOWN(sizeof(C)*newCapacity,"DArray<>");
+    void* mem = ALLOC_KNOWN(sizeof(C)*newCapacity,"Lib::DArray");
     C* newArray=array_new<C>(mem, newCapacity);
 
     if(_array) {
       array_delete(_array, _capacity);
-      DEALLOC_KNOWN(_array,sizeof(C)*_capacity,"DArray<>");
+      DEALLOC_KNOWN(_array,sizeof(C)*_capacity,"Lib::DArray");
     }
     _size = s;
     _capacity = newCapacity;
@@ -189,7 +189,7 @@ public:
 
     size_t oldCapacity=_capacity;
     size_t newCapacity=std::max(s, oldCapacity*2);
-    void* mem = ALLOC_KNOWN(sizeof(C)*newCapacity,"DArray<>");
+    void* mem = ALLOC_KNOWN(sizeof(C)*newCapacity,"Lib::DArray");
 
     C* oldArr = _array;
 
@@ -212,7 +212,7 @@ public:
     _size = s;
 
     if(oldArr) {
-      DEALLOC_KNOWN(oldArr,sizeof(C)*oldCapacity,"DArray<>");
+      DEALLOC_KNOWN(oldArr,sizeof(C)*oldCapacity,"Lib::DArray");
     }
 
   } // expand
@@ -101,7 +101,7 @@ public:
     if(_entries) {
       ASS_EQ(_afterLast-_entries,_capacity);
       array_delete(_entries, _capacity);
-      DEALLOC_KNOWN(_entries,_capacity*sizeof(Entry),"DHMap::Entry");
+      DEALLOC_KNOWN(_entries,_capacity*sizeof(Entry),"Lib::DHMap::Entry");
     }
   }
 
@@ -518,7 +518,7 @@ private:
     }
 
     int newCapacity=DHMapTableCapacities[_capacityIndex+1];
-    void* mem = ALLOC_KNOWN(newCapacity*sizeof(Entry),"DHMap::Entry");
+    void* mem = ALLOC_KNOWN(newCapacity*sizeof(Entry),"Lib::DHMap::Entry");
 
 
     Entry* oldEntries=_entries;
@@ -545,7 +545,7 @@ private:
       (ep++)->~Entry();
     }
     if(oldCapacity) {
-      DEALLOC_KNOWN(oldEntries,oldCapacity*sizeof(Entry),"DHMap::Entry");
+      DEALLOC_KNOWN(oldEntries,oldCapacity*sizeof(Entry),"Lib::DHMap::Entry");
     }
   }
 
@@ -67,7 +67,7 @@ public:
   {
     if(_entries) {
       array_delete(_entries, _capacity);
-      DEALLOC_KNOWN(_entries,_capacity*sizeof(Entry),"DHMultiset::Entry");
+      DEALLOC_KNOWN(_entries,_capacity*sizeof(Entry),"Lib::DHMultiset::Entry");
     }
   }
 
@@ -246,7 +246,7 @@ private:
     }
 
     int newCapacity=DHMapTableCapacities[_capacityIndex+1];
-    void* mem = ALLOC_KNOWN(newCapacity*sizeof(Entry),"DHMultiset::Entry");
+    void* mem = ALLOC_KNOWN(newCapacity*sizeof(Entry),"Lib::DHMultiset::Entry");
 
     Entry* oldEntries=_entries;
     Entry* oldAfterLast=_afterLast;
@@ -271,7 +271,7 @@ private:
     }
 
     if(oldCapacity) {
-      DEALLOC_KNOWN(oldEntries,oldCapacity*sizeof(Entry),"DHMultiset::Entry");
+      DEALLOC_KNOWN(oldEntries,oldCapacity*sizeof(Entry),"Lib::DHMultiset::Entry");
     }
   }
 
@@ -49,7 +49,7 @@ public:
   {
     ASS_G(initialCapacity,1);
 
-    void* mem = ALLOC_KNOWN(_capacity*sizeof(C),"Deque<>");
+    void* mem = ALLOC_KNOWN(_capacity*sizeof(C),"Lib::Deque");
     _data = static_cast<C*>(mem);
     _front = _data;
     _back = _data;
@@ -68,7 +68,7 @@ public:
       }
       (--p)->~C();
     }
-    DEALLOC_KNOWN(_data,_capacity*sizeof(C),"Deque<>");
+    DEALLOC_KNOWN(_data,_capacity*sizeof(C),"Lib::Deque");
   }
 
   /**
@@ -445,7 +445,7 @@ protected:
     size_t newCapacity = 2 * _capacity;
 
     // allocate new stack and copy old stack's content to the new place
-    void* mem = ALLOC_KNOWN(newCapacity*sizeof(C),"Deque<>");
+    void* mem = ALLOC_KNOWN(newCapacity*sizeof(C),"Lib::Deque");
 
     C* newData = static_cast<C*>(mem);
     C* oldPtr=_front;
@@ -460,7 +460,7 @@ protected:
     }
     ASS_EQ(oldPtr, _back);
     // deallocate the old stack
-    DEALLOC_KNOWN(_data,_capacity*sizeof(C),"Deque<>");
+    DEALLOC_KNOWN(_data,_capacity*sizeof(C),"Lib::Deque");
 
     _data = newData;
     _front = _data;
@@ -27,17 +27,17 @@ IntUnionFind::IntUnionFind(int cnt)
 {
   ASS_G(cnt, 0);
 
-  _parents=reinterpret_cast<int*>(ALLOC_KNOWN(_cnt*sizeof(int), "IntUnionFind"));
+  _parents=reinterpret_cast<int*>(ALLOC_KNOWN(_cnt*sizeof(int), "Lib::IntUnionFind"));
   for(int i=0;i<_cnt;i++) {
     _parents[i]=-1;
   }
-  _data=reinterpret_cast<int*>(ALLOC_KNOWN(_cnt*sizeof(int), "IntUnionFind"));
+  _data=reinterpret_cast<int*>(ALLOC_KNOWN(_cnt*sizeof(int), "Lib::IntUnionFind"));
 }
 
 IntUnionFind::~IntUnionFind()
 {
-  DEALLOC_KNOWN(_parents, _cnt*sizeof(int), "IntUnionFind");
-  DEALLOC_KNOWN(_data, _cnt*sizeof(int), "IntUnionFind");
+  DEALLOC_KNOWN(_parents, _cnt*sizeof(int), "Lib::IntUnionFind");
+  DEALLOC_KNOWN(_data, _cnt*sizeof(int), "Lib::IntUnionFind");
 }
 
 
@@ -67,7 +67,7 @@ void IntegerSet::insert (int n)
     if (words < index+1) {
       words = index+1;
     }
-    void* mem = ALLOC_KNOWN(sizeof(unsigned)*words,"IntegerSet");
+    void* mem = ALLOC_KNOWN(sizeof(unsigned)*words,"Lib::IntegerSet");
     unsigned int* set = array_new<unsigned>(mem, words);
     for (int i = _words-1;i >= 0;i--) {
       set[i] = _set[i];
@@ -77,7 +77,7 @@ void IntegerSet::insert (int n)
     }
     if (_set) {
       array_delete(_set, _words);
-      DEALLOC_KNOWN(_set,sizeof(unsigned)*_words,"IntegerSet");
+      DEALLOC_KNOWN(_set,sizeof(unsigned)*_words,"Lib::IntegerSet");
     }
     _set = set;
     _words = words;
@@ -93,6 +93,6 @@ IntegerSet::~IntegerSet()
 {
   if (_set) {
     array_delete(_set, _words);
-    DEALLOC_KNOWN(_set,sizeof(unsigned)*_words,"IntegerSet");
+    DEALLOC_KNOWN(_set,sizeof(unsigned)*_words,"Lib::IntegerSet");
   }
 } // IntegerSet::~IntegerSet
@@ -141,7 +141,7 @@ public:
   explicit Map (Map const& other)
     : _capacity(other._capacity),
       _noOfEntries(other._noOfEntries),
-      _entries((Entry*)ALLOC_KNOWN(sizeof(Entry)*_capacity,"Map<>")),
+      _entries((Entry*)ALLOC_KNOWN(sizeof(Entry)*_capacity,"Lib::Map")),
       _afterLast  (_entries + (other._afterLast - other._entries)),
       _maxEntries (other._maxEntries)
   {
@@ -501,7 +501,7 @@ public:
   {
     if (_entries) {
       array_delete(_entries, _capacity);
-      DEALLOC_KNOWN(_entries,sizeof(Entry)*_capacity,"Map<>");
+      DEALLOC_KNOWN(_entries,sizeof(Entry)*_capacity,"Lib::Map");
     }
     _capacity    = 0;
     _noOfEntries = 0;
@@ -578,7 +578,7 @@ public:
 
     Entry* oldEntries = _entries;
 
-    void* mem = ALLOC_KNOWN(sizeof(Entry)*_capacity,"Map<>");
+    void* mem = ALLOC_KNOWN(sizeof(Entry)*_capacity,"Lib::Map");
     _entries = array_new<Entry>(mem, _capacity);
 
     _afterLast = _entries + _capacity;
@@ -606,7 +606,7 @@ public:
     }
     if (oldEntries) {
       array_delete(oldEntries, oldCapacity);
-      DEALLOC_KNOWN(oldEntries,sizeof(Entry)*oldCapacity,"Map<>");
+      DEALLOC_KNOWN(oldEntries,sizeof(Entry)*oldCapacity,"Lib::Map");
     }
   } // Map::expand
 
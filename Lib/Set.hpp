@@ -107,7 +107,7 @@ public:
   {
     if (_entries) {
       array_delete(_entries,_capacity);
-      DEALLOC_KNOWN(_entries,_capacity*sizeof(Cell),"Set::Cell");
+      DEALLOC_KNOWN(_entries,_capacity*sizeof(Cell),"Lib::Set::Cell");
     }
   } // Set::~Set
 
@@ -361,7 +361,7 @@ private:
     size_t newCapacity = _capacity ? _capacity * 2 : 31;
     Cell* oldEntries = _entries;
 
-    void* mem = ALLOC_KNOWN(newCapacity*sizeof(Cell),"Set::Cell");
+    void* mem = ALLOC_KNOWN(newCapacity*sizeof(Cell),"Lib::Set::Cell");
 
     _entries = array_new<Cell>(mem, newCapacity);
     _afterLast = _entries + newCapacity;
@@ -394,7 +394,7 @@ private:
 
     if (oldEntries) {
       array_delete(oldEntries,oldCapacity);
-      DEALLOC_KNOWN(oldEntries,oldCapacity*sizeof(Cell),"Set::Cell");
+      DEALLOC_KNOWN(oldEntries,oldCapacity*sizeof(Cell),"Lib::Set::Cell");
     }
   } // Set::expand
 
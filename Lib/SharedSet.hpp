@@ -401,7 +401,7 @@ private:
     size_t size=sizeof(SharedSet)+length*sizeof(T);
     size-=sizeof(T);
 
-    return ALLOC_KNOWN(size,"SharedSet");
+    return ALLOC_KNOWN(size,"Lib::SharedSet");
   }
   
   void operator delete (void* obj)
@@ -414,7 +414,7 @@ private:
     size-=sizeof(T);
     )
   
-    DEALLOC_KNOWN(obj, size,"SharedSet");
+    DEALLOC_KNOWN(obj, size,"Lib::SharedSet");
   }
 
   size_t _size;
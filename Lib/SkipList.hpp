@@ -539,7 +539,7 @@ private:
   inline
   static Node* allocate(unsigned h)
   {
-    void* memory = ALLOC_KNOWN(sizeof(Node)+h*sizeof(Node*),"SkipList::Node");
+    void* memory = ALLOC_KNOWN(sizeof(Node)+h*sizeof(Node*),"Lib::SkipList::Node");
 
     return reinterpret_cast<Node*>(memory);
   }
@@ -548,7 +548,7 @@ private:
   inline
   static void deallocate(Node* node,unsigned h)
   {
-    DEALLOC_KNOWN(node,sizeof(Node)+h*sizeof(Node*),"SkipList::Node");
+    DEALLOC_KNOWN(node,sizeof(Node)+h*sizeof(Node*),"Lib::SkipList::Node");
   }
 
 
@@ -68,7 +68,7 @@ public:
     : _capacity(initialCapacity)
   {
     if(_capacity) {
-      void* mem = ALLOC_KNOWN(_capacity*sizeof(C),className());
+      void* mem = ALLOC_KNOWN(_capacity*sizeof(C),"Lib::Stack");
       _stack = static_cast<C*>(mem);
     }
     else {
@@ -84,12 +84,12 @@ public:
     if (_capacity >= capacity) {
       return;
     }
-    C* mem = static_cast<C*>(ALLOC_KNOWN(capacity*sizeof(C),className()));
+    C* mem = static_cast<C*>(ALLOC_KNOWN(capacity*sizeof(C),"Lib::Stack"));
     if (_stack) {
       for (unsigned i = 0; i < size(); i++) {
         ::new(&mem[i]) C(std::move((*this)[i]));
       }
-      DEALLOC_KNOWN(_stack,_capacity*sizeof(C),className());
+      DEALLOC_KNOWN(_stack,_capacity*sizeof(C),"Lib::Stack");
 
       _cursor = mem + (_cursor - _stack);
       _capacity = capacity;
@@ -110,7 +110,7 @@ public:
    : _capacity(s._capacity)
   {
     if(_capacity) {
-      void* mem = ALLOC_KNOWN(_capacity*sizeof(C),className());
+      void* mem = ALLOC_KNOWN(_capacity*sizeof(C),"Lib::Stack");
       _stack = static_cast<C*>(mem);
     }
     else {
@@ -143,7 +143,7 @@ public:
       (--p)->~C();
     }
     if(_stack) {
-      DEALLOC_KNOWN(_stack,_capacity*sizeof(C),className());
+      DEALLOC_KNOWN(_stack,_capacity*sizeof(C),"Lib::Stack");
     }
     else {
       ASS_EQ(_capacity,0);
@@ -826,7 +826,7 @@ protected:
     size_t newCapacity = _capacity ? (2 * _capacity) : 8;
 
     // allocate new stack and copy old stack's content to the new place
-    void* mem = ALLOC_KNOWN(newCapacity*sizeof(C),className());
+    void* mem = ALLOC_KNOWN(newCapacity*sizeof(C),"Lib::Stack");
 
     C* newStack = static_cast<C*>(mem);
     if(_capacity) {
@@ -835,7 +835,7 @@ protected:
         _stack[i].~C();
       }
       // deallocate the old stack
-      DEALLOC_KNOWN(_stack,_capacity*sizeof(C),className());
+      DEALLOC_KNOWN(_stack,_capacity*sizeof(C),"Lib::Stack");
     }
 
     _stack = newStack;
@@ -0,0 +1,136 @@
+/*
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ */
+/**
+ * @file StripedSet.hpp
+ * Defines class StripedSet<Val,Hash>, a Set split into independent stripes.
+ */
+
+#ifndef __StripedSet__
+#define __StripedSet__
+
+#include <atomic>
+#include <mutex>
+
+#include "Set.hpp"
+
+namespace Lib {
+
+/**
+ * A set with the same find-or-insert interface as Set, made of 2^STRIPE_BITS
+ * independent Sets ("stripes"). A value lives in the stripe given by the top bits of its hash.
+ *
+ * Each stripe is guarded by a lock of its own, so find() and rawFindOrInsert()
+ * may be called from several threads at once, and only block each other
+ * when they hit the same stripe. The values are returned by copy, as a stripe
+ * may get rehashed by another thread as soon as its lock is released.
+ * Creating a value (see rawFindOrInsert()) happens under the lock of its stripe,
+ * but must itself be safe to run in parallel with the creation of other values.
+ * Iteration is not synchronised, and must not run concurrently with insertions.
+ *
+ * Each stripe also grows on its own, so instead of rehashing all the values at once
+ * (which for the term bank means a long pause, and for its duration the memory
+ * of the old table plus the twice as big new one), only a fraction of them gets
+ * rehashed at a time.
+ */
+template <typename Val, typename Hash, unsigned STRIPE_BITS = 4>
+class StripedSet
+{
+  static_assert(STRIPE_BITS > 0 && STRIPE_BITS < 16, "unreasonable number of stripes");
+  static const unsigned STRIPES = 1u << STRIPE_BITS;
+
+  struct Stripe {
+    Set<Val,Hash> values;
+    mutable std::mutex lock;
+  };
+
+public:
+  StripedSet() : _size(0) {}
+
+  /** @see Set::find */
+  template<typename Key>
+  bool find(Key key, Val& result) const
+  {
+    const Stripe& stripe = stripeFor(Hash::hash(key));
+    std::lock_guard<std::mutex> guard(stripe.lock);
+    return stripe.values.find(key, result);
+  }
+
+  /** @see Set::rawFindOrInsert */
+  template<class Create, class IsCorrectVal>
+  Val rawFindOrInsert(Create create, unsigned hashCode, IsCorrectVal isCorrectVal, bool& inserted)
+  {
+    Stripe& stripe = stripeFor(hashCode);
+    std::lock_guard<std::mutex> guard(stripe.lock);
+    Val res = stripe.values.rawFindOrInsert(std::move(create), hashCode, std::move(isCorrectVal), inserted);
+    if (inserted) {
+      _size++;
+    }
+    return res;
+  }
+
+  template<class Create, class IsCorrectVal>
+  Val rawFindOrInsert(Create create, unsigned hashCode, IsCorrectVal isCorrectVal)
+  { bool b; return rawFindOrInsert(std::move(create), hashCode, std::move(isCorrectVal), b); }
+
+  /** @see Set::insert */
+  Val insert(const Val val)
+  {
+    unsigned code = Hash::hash(val);
+    return rawFindOrInsert([&]() { return val; }, code, [&](auto v) { return Hash::equals(v, val); });
+  }
+
+  /** Return the number of elements */
+  unsigned size() const { return _size; }
+
+  /**
+   * Iterate over the values stored in the set, stripe by stripe.
+   */
+  class Iterator {
+  public:
+    DECL_ELEMENT_TYPE(Val);
+
+    explicit Iterator(const StripedSet& set) : _set(set), _stripe(0), _inner(set._stripes[0].values) {}
+
+    bool hasNext()
+    {
+      while (!_inner.hasNext()) {
+        if (_stripe + 1 == STRIPES) {
+          return false;
+        }
+        _inner = typename Set<Val,Hash>::Iterator(_set._stripes[++_stripe].values);
+      }
+      return true;
+    }
+
+    Val next() { return _inner.next(); }
+
+  private:
+    const StripedSet& _set;
+    unsigned _stripe;
+    typename Set<Val,Hash>::Iterator _inner;
+  };
+
+private:
+  StripedSet(const StripedSet&) = delete;
+
+  static unsigned stripeIndex(unsigned hashCode)
+  { return hashCode >> (32 - STRIPE_BITS); }
+  Stripe& stripeFor(unsigned hashCode)
+  { return _stripes[stripeIndex(hashCode)]; }
+  const Stripe& stripeFor(unsigned hashCode) const
+  { return _stripes[stripeIndex(hashCode)]; }
+
+  Stripe _stripes[STRIPES];
+  std::atomic<unsigned> _size;
+}; // class StripedSet
+
+} // namespace Lib
+
+#endif // __StripedSet__
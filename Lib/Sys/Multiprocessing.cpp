@@ -75,6 +75,28 @@ pid_t Multiprocessing::waitForChildTermination(int& resValue)
   return childPid;
 }
 
+/**
+ * Wait until all the children of the current process terminate,
+ * including the descendants it adopted as a child subreaper.
+ */
+void Multiprocessing::waitForAllChildren()
+{
+  TIME_TRACE("waiting for child")
+
+  int status;
+  for(;;) {
+    errno=0;
+    if(wait(&status)==-1) {
+      if(errno==ECHILD) {
+        return;
+      }
+      if(errno!=EINTR) {
+        SYSTEM_FAIL("Call to wait() function failed.", errno);
+      }
+    }
+  }
+}
+
 void Multiprocessing::kill(pid_t child, int signal)
 {
   int res = ::kill(child, signal);
@@ -89,14 +111,22 @@ void Multiprocessing::killNoCheck(pid_t child, int signal)
   ::kill(child, signal);
 }
 
-pid_t Multiprocessing::poll_children(bool &exited, bool &signalled, int &code)
+/**
+ * Wait for a child to change state and return its pid.
+ * If @b block is false, return 0 immediately if no child has changed state.
+ */
+pid_t Multiprocessing::poll_children(bool &exited, bool &signalled, int &code, bool block)
 {
   int status;
-  pid_t pid = waitpid(-1 /*wait for any child*/, &status, WUNTRACED);
+  pid_t pid = waitpid(-1 /*wait for any child*/, &status, block ? WUNTRACED : WUNTRACED | WNOHANG);
 
   if (pid == -1) {
     SYSTEM_FAIL("Call to waitpid() function failed.", errno);
   }
+  if (pid == 0) {
+    exited = signalled = false;
+    return 0;
+  }
 
   exited = WIFEXITED(status);
   signalled = WIFSIGNALED(status);
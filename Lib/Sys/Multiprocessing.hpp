@@ -25,11 +25,12 @@ public:
   static Multiprocessing* instance();
 
   pid_t waitForChildTermination(int& resValue);
+  void waitForAllChildren();
   pid_t fork();
 
   void kill(pid_t child, int signal);
   void killNoCheck(pid_t child, int signal);
-  pid_t poll_children(bool &exited, bool &signalled, int &code);
+  pid_t poll_children(bool &exited, bool &signalled, int &code, bool block = true);
 };
 
 }
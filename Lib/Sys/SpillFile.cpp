@@ -0,0 +1,114 @@
+/*
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ */
+/**
+ * @file SpillFile.cpp
+ * Implements class SpillFile.
+ */
+
+#include <cerrno>
+#include <utility>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#include "Debug/Assertion.hpp"
+#include "Lib/Exception.hpp"
+
+#include "SpillFile.hpp"
+
+namespace Lib
+{
+namespace Sys
+{
+
+SpillFile::~SpillFile()
+{
+  if (_mapped) {
+    munmap(_mapped, _size);
+  }
+  if (_file) {
+    std::fclose(_file);
+  }
+}
+
+/**
+ * Append @b size bytes from @b data to the file
+ */
+void SpillFile::append(const void* data, size_t size)
+{
+  ASS(!_mapped);
+
+  if (!_file) {
+    errno = 0;
+    _file = std::tmpfile();
+    if (!_file) {
+      SYSTEM_FAIL("Call to tmpfile() function failed.", errno);
+    }
+  }
+  errno = 0;
+  if (std::fwrite(data, 1, size, _file) != size) {
+    SYSTEM_FAIL("Writing to a spill file failed.", errno);
+  }
+  _size += size;
+}
+
+/**
+ * Return the content of the file, which must not be empty.
+ * It stays mapped until the file is cleared.
+ */
+const char* SpillFile::map()
+{
+  ASS(!_mapped);
+  ASS_G(_size, 0);
+
+  errno = 0;
+  if (std::fflush(_file) != 0) {
+    SYSTEM_FAIL("Writing to a spill file failed.", errno);
+  }
+  void* mapped = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fileno(_file), 0);
+  if (mapped == MAP_FAILED) {
+    SYSTEM_FAIL("Call to mmap() function failed.", errno);
+  }
+  // the content is read from the start to the end
+  madvise(mapped, _size, MADV_SEQUENTIAL);
+  _mapped = mapped;
+  return static_cast<const char*>(_mapped);
+}
+
+/**
+ * Remove the content of the file
+ */
+void SpillFile::clear()
+{
+  if (_mapped) {
+    munmap(_mapped, _size);
+    _mapped = nullptr;
+  }
+  if (_file) {
+    std::rewind(_file);
+    errno = 0;
+    if (ftruncate(fileno(_file), 0) != 0) {
+      SYSTEM_FAIL("Call to ftruncate() function failed.", errno);
+    }
+  }
+  _size = 0;
+}
+
+/**
+ * Exchange the files and the contents with @b other
+ */
+void SpillFile::swap(SpillFile& other)
+{
+  std::swap(_file, other._file);
+  std::swap(_size, other._size);
+  std::swap(_mapped, other._mapped);
+}
+
+}
+}
@@ -0,0 +1,56 @@
+/*
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ */
+/**
+ * @file SpillFile.hpp
+ * Defines class SpillFile.
+ */
+
+#ifndef __SpillFile__
+#define __SpillFile__
+
+#include <cstddef>
+#include <cstdio>
+
+namespace Lib {
+namespace Sys {
+
+/**
+ * A temporary file for data that need not stay in memory for a while.
+ *
+ * Blocks of bytes are appended to the file, and its whole content is read back
+ * through a memory mapping. The file has no name, it disappears with the process.
+ *
+ * To keep a part of the content, it is appended to another spill file while
+ * this one is mapped, and the files are swapped.
+ */
+class SpillFile {
+public:
+  SpillFile() : _file(nullptr), _size(0), _mapped(nullptr) {}
+  ~SpillFile();
+
+  void append(const void* data, size_t size);
+  const char* map();
+  void clear();
+  void swap(SpillFile& other);
+
+  /** Return the number of bytes in the file */
+  size_t size() const { return _size; }
+
+private:
+  std::FILE* _file;
+  size_t _size;
+  /** the mapping of the content, or nullptr if not mapped */
+  void* _mapped;
+};
+
+}
+}
+
+#endif // __SpillFile__
@@ -16,6 +16,7 @@
 #include "Portability.hpp"
 
 #include <csignal>
+#include <unistd.h>
 
 #ifdef __linux__
 #include <sys/prctl.h>
@@ -156,4 +157,53 @@ void System::registerForSIGHUPOnParentDeath()
 #endif
 }
 
+/**
+ * Make the current process adopt its orphaned descendants (instead of init),
+ * so that they can be waited for as if they were its own children.
+ *
+ * Return false if this is not supported on the current platform.
+ */
+bool System::becomeChildSubreaper()
+{
+#if defined(__linux__) && defined(PR_SET_CHILD_SUBREAPER)
+  return prctl(PR_SET_CHILD_SUBREAPER, 1) == 0;
+#else
+  return false;
+#endif
+}
+
+/**
+ * Block until @b parent, the process which forked the current one, terminates
+ * and the current process gets adopted, by init or by a child subreaper
+ * (see becomeChildSubreaper()). Return immediately if this already happened.
+ *
+ * Afterwards getppid() returns the adopting process.
+ */
+void System::waitForParentDeath(pid_t parent)
+{
+#ifdef __linux__
+  // the kernel sends the parent death signal only after reparenting the process,
+  // so we block it and wait for it to arrive
+  sigset_t wakeup, original;
+  sigemptyset(&wakeup);
+  sigaddset(&wakeup, SIGUSR1);
+  sigprocmask(SIG_BLOCK, &wakeup, &original);
+  prctl(PR_SET_PDEATHSIG, SIGUSR1);
+  if (getppid() == parent) {
+    int sig;
+    sigwait(&wakeup, &sig);
+  } else {
+    // the parent died before we checked, consume the signal if it was sent
+    timespec noWait = {0, 0};
+    sigtimedwait(&wakeup, nullptr, &noWait);
+  }
+  prctl(PR_SET_PDEATHSIG, 0);
+  sigprocmask(SIG_SETMASK, &original, nullptr);
+#else
+  while (getppid() == parent) {
+    sleep(1);
+  }
+#endif
+}
+
 };
@@ -18,6 +18,7 @@
 #define __System__
 
 #include <cstdlib>
+#include <sys/types.h>
 
 enum {
   VAMP_RESULT_STATUS_SUCCESS,
@@ -38,6 +39,8 @@ public:
   }
 
   static void registerForSIGHUPOnParentDeath();
+  static bool becomeChildSubreaper();
+  static void waitForParentDeath(pid_t parent);
 };
 
 }
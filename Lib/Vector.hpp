@@ -64,7 +64,7 @@ public:
     ASS_G(length,0);
 
     size_t sz=sizeof(Vector) + (length-1)*sizeof(C);
-    Vector* v = reinterpret_cast<Vector*>(ALLOC_KNOWN(sz,"Vector"));
+    Vector* v = reinterpret_cast<Vector*>(ALLOC_KNOWN(sz,"Lib::Vector"));
     v->_length = length;
     C* arr = v->_array;
     // in the case C is a class with an initialiser, apply the constructor of it
@@ -80,7 +80,7 @@ public:
     // to every element of the allocated array
     array_delete(_array, _length);
     size_t sz=sizeof(Vector) + (_length-1)*sizeof(C);
-    DEALLOC_KNOWN(this,sz,"Vector");
+    DEALLOC_KNOWN(this,sz,"Lib::Vector");
   } // deallocate
 
   bool operator==(const Vector& v) const
@@ -56,7 +56,7 @@ void* SATClause::operator new(size_t sz,unsigned lits)
   if (lits > 0)
     size-=sizeof(SATLiteral);
 
-  return ALLOC_KNOWN(size,"SATClause");
+  return ALLOC_KNOWN(size,"SAT::SATClause");
 }
 
 void SATClause::operator delete(void *ptr, size_t sz) {
@@ -65,7 +65,7 @@ void SATClause::operator delete(void *ptr, size_t sz) {
   if(self->_length > 0)
     size -= sizeof(SATLiteral);
 
-  DEALLOC_KNOWN(ptr, size, "SATClause");
+  DEALLOC_KNOWN(ptr, size, "SAT::SATClause");
 }
 
 SATClause::SATClause(unsigned length)
@@ -113,7 +113,7 @@ void SATClause::destroy()
   // call a destructor of the clause object (will destroy _literals[0])
   this->~SATClause();
     
-  DEALLOC_KNOWN(this, size,"SATClause");
+  DEALLOC_KNOWN(this, size,"SAT::SATClause");
 } // SATClause::destroy
 
 
@@ -16,7 +16,9 @@
 #include <cmath>
 
 #include "Debug/RuntimeStatistics.hpp"
+#include "Debug/TimeProfiling.hpp"
 
+#include "Lib/Allocator.hpp"
 #include "Lib/Environment.hpp"
 #include "Lib/Int.hpp"
 #include "Lib/Random.hpp"
@@ -42,101 +44,118 @@ using namespace Lib;
 using namespace Kernel;
 
 /**
- * Weight comparison of clauses.
- * @return the result of comparison (LESS, EQUAL or GREATER)
- * @warning if the option increased_numeral_weight is on, then each comparison
- *          recomputes the numeral weight of clauses, see Clause::getNumeralWeight(), so it
- *          it can be expensive
+ * The key of a clause within its bucket, the same for the age and the weight queue:
+ * the clauses of a bucket are ordered
+ * <ol><li>by age (only needed if the buckets are by the number of reductions);</li>
+ *     <li>by input type, the larger first;</li>
+ *     <li>by number.</li>
+ * </ol>
+ * The age saturates at 2^29-1, which leaves 3 bits for the input type and 32 for the number.
  */
-static Comparison compareWeight(Clause* cl1, Clause* cl2, const Options& opt)
+template<class C>
+static std::uint64_t clauseEntryKey(C* cl)
 {
-  return Int::compare(cl1->weightForClauseSelection(opt), cl2->weightForClauseSelection(opt));
+  static const unsigned MAX_INPUT_TYPE = 7;
+  ASS_LE(toNumber(cl->inputType()), MAX_INPUT_TYPE);
+  std::uint64_t age = std::min(cl->age(), (1u << 29) - 1);
+  return (age << 35) | (std::uint64_t(MAX_INPUT_TYPE - toNumber(cl->inputType())) << 32) | cl->number();
+}
+
+AgeQueue::OrdVal AgeQueue::getOrdVal(Clause* cl) const
+{
+  return std::make_pair(cl->age(),cl->weightForClauseSelection(_opt));
 }
 
 /**
- * Comparison of clauses. The comparison uses four orders in the
- * following order:
+ * The order of the age queue is
  * <ol><li>by age;</li>
  *     <li>by weight;</li>
- *     <li>by input type;</li>
+ *     <li>by input type, the larger first;</li>
  *     <li>by number.</li>
  * </ol>
- * @since 30/12/2007 Manchester
+ * The clauses with the same age and weight form a bucket.
  */
-bool AgeQueue::lessThan(Clause* c1,Clause* c2)
+template<class C>
+std::uint64_t AgeQueue::bucketKey(C* cl) const
 {
-  if (c1->age() < c2->age()) {
-    return true;
-  }
-  if (c2->age() < c1->age()) {
-    return false;
-  }
+  return (std::uint64_t(cl->age()) << 32) | cl->weightForClauseSelection(_opt);
+}
 
-  Comparison weightCmp=compareWeight(c1, c2, _opt);
-  if (weightCmp!=EQUAL) {
-    return weightCmp==LESS;
-  }
+template<class C>
+std::uint64_t AgeQueue::entryKey(C* cl) const
+{
+  return clauseEntryKey(cl);
+}
 
-  if (c1->inputType() < c2->inputType()) {
-    return false;
-  }
-  if (c2->inputType() < c1->inputType()) {
-    return true;
-  }
+template std::uint64_t AgeQueue::bucketKey(Clause*) const;
+template std::uint64_t AgeQueue::bucketKey(CompactClause*) const;
+template std::uint64_t AgeQueue::entryKey(Clause*) const;
+template std::uint64_t AgeQueue::entryKey(CompactClause*) const;
 
-  return c1->number() < c2->number();
-} // AgeQueue::lessThan
+WeightQueue::WeightQueue(const Options& opt)
+  : _opt(opt), _prioritiseLongReductions(opt.prioritiseClausesProducedByLongReduction())
+{
+}
 
-AgeQueue::OrdVal AgeQueue::getOrdVal(Clause* cl) const
+WeightQueue::OrdVal WeightQueue::getOrdVal(Clause* cl) const
 {
-  return std::make_pair(cl->age(),cl->weightForClauseSelection(_opt));
+  return std::make_pair(cl->weightForClauseSelection(_opt),cl->age());
 }
 
 /**
- * Comparison of clauses. The comparison uses four orders in the
- * following order:
- * <ol><li>by weight;</li>
+ * The order of the weight queue is
+ * <ol><li>by the number of reductions, the larger first, if the clauses produced by long reductions come first;</li>
+ *     <li>by weight;</li>
  *     <li>by age;</li>
- *     <li>by input type;</li>
+ *     <li>by input type, the larger first;</li>
  *     <li>by number.</li>
  * </ol>
- * @since 30/12/2007 Manchester
+ * The clauses with the same weight and age form a bucket. If the clauses
+ * produced by long reductions come first, a bucket is formed by the clauses
+ * with the same number of reductions and weight.
  */
-bool WeightQueue::lessThan(Clause* c1,Clause* c2)
+template<class C>
+std::uint64_t WeightQueue::bucketKey(C* cl) const
 {
-  if(env.options->prioritiseClausesProducedByLongReduction()){
-    if(c1->inference().reductions() < c2->inference().reductions()){
-      return false;
-    }
-
-    if(c2->inference().reductions() < c1->inference().reductions()){
-      return true;
-    }
+  if (_prioritiseLongReductions) {
+    return (std::uint64_t(UINT_MAX - cl->inference().reductions()) << 32) | cl->weightForClauseSelection(_opt);
   }
+  return (std::uint64_t(cl->weightForClauseSelection(_opt)) << 32) | cl->age();
+}
 
-  Comparison weightCmp=compareWeight(c1, c2, _opt);
-  if (weightCmp!=EQUAL) {
-    return weightCmp==LESS;
-  }
+template<class C>
+std::uint64_t WeightQueue::entryKey(C* cl) const
+{
+  return clauseEntryKey(cl);
+}
 
-  if (c1->age() < c2->age()) {
-    return true;
-  }
-  if (c2->age() < c1->age()) {
-    return false;
-  }
-  if (c1->inputType() < c2->inputType()) {
-    return false;
-  }
-  if (c2->inputType() < c1->inputType()) {
-    return true;
-  }
-  return c1->number() < c2->number();
-} // WeightQueue::lessThan
+template std::uint64_t WeightQueue::bucketKey(Clause*) const;
+template std::uint64_t WeightQueue::bucketKey(CompactClause*) const;
+template std::uint64_t WeightQueue::entryKey(Clause*) const;
+template std::uint64_t WeightQueue::entryKey(CompactClause*) const;
 
-WeightQueue::OrdVal WeightQueue::getOrdVal(Clause* cl) const
+/**
+ * The references to a passive clause which do not point to it from anywhere: the one
+ * SaturationAlgorithm keeps on every clause retained by forward simplification.
+ * The compact form of a clause drops it, and the clause gets it back when materialized.
+ */
+static const unsigned RETAINED_REFERENCES = 1;
+
+/**
+ * Keeping the passive clauses in their compact form is possible only if nothing
+ * refers to them while they are passive. This is the case with the discount
+ * saturation algorithm, whose passive clauses are not used for simplification,
+ * and when the container is not a part of a split queue.
+ * Some options would keep the clauses in tables of their own.
+ */
+static bool canCompactClauses(bool isOutermost, const Options& opt)
 {
-  return std::make_pair(cl->weightForClauseSelection(_opt),cl->age());
+  return isOutermost && opt.compactPassive() &&
+    opt.saturationAlgorithm() == Options::SaturationAlgorithm::DISCOUNT &&
+    opt.proofExtra() != Options::ProofExtra::FULL &&
+    opt.mode() != Options::Mode::CONSEQUENCE_ELIMINATION &&
+    !opt.showSymbolElimination() &&
+    !opt.partialRedundancyCheck();
 }
 
 
@@ -144,6 +163,16 @@ AWPassiveClauseContainer::AWPassiveClauseContainer(bool isOutermost, const Shell
   PassiveClauseContainer(isOutermost, opt, name),
   _ageQueue(opt),
   _weightQueue(opt),
+  _compactAgeQueue(_ageQueue),
+  _compactWeightQueue(_weightQueue),
+  _compact(canCompactClauses(isOutermost, opt)),
+  _compactSize(0),
+  _compactBytes(0),
+  _spilledSize(0),
+  _spillAgeKey(UINT64_MAX),
+  _spillWeightKey(UINT64_MAX),
+  _spillBytes(_compact ? size_t(opt.passiveSpillMemory()) << 20 : 0),
+  _spillThreshold(_spillBytes),
   _ageRatio(opt.ageRatio()),
   _weightRatio(opt.weightRatio()),
   _balance(0),
@@ -164,13 +193,25 @@ AWPassiveClauseContainer::AWPassiveClauseContainer(bool isOutermost, const Shell
 
 AWPassiveClauseContainer::~AWPassiveClauseContainer()
 {
-  ClauseQueue::Iterator cit(_ageQueue);
+  AgeQueue::Iterator cit(_ageQueue);
   while (cit.hasNext())
   {
     Clause* cl=cit.next();
     ASS(!_isOutermost || cl->store()==Clause::PASSIVE);
     cl->setStore(Clause::NONE);
   }
+  CompactClauseQueue<AgeQueue>::Iterator ccit(_compactAgeQueue);
+  while (ccit.hasNext()) {
+    ccit.next()->destroy();
+  }
+  if (_spilledSize) {
+    const char* data = _spillFile.map();
+    for (unsigned i = 0; i < _spilledSize; i++) {
+      CompactClause* ccl = CompactClause::fromBytes(data);
+      data += ccl->bytes();
+      ccl->destroy();
+    }
+  }
 }
 
 /**
@@ -181,6 +222,22 @@ void AWPassiveClauseContainer::add(Clause* cl)
 {
   ASS(cl->store() == Clause::PASSIVE);
 
+  if (_compact && CompactClause::canCompact(cl, RETAINED_REFERENCES)) {
+    _size++;
+    // the clause object is destroyed when replaced by the compact form
+    addedEvent.fire(cl);
+    CompactClause* ccl = CompactClause::fromClause(cl, _opt, RETAINED_REFERENCES);
+    _compactAgeQueue.insert(ccl);
+    _compactWeightQueue.insert(ccl);
+    _compactSize++;
+    _compactBytes += ccl->bytes();
+
+    if (_spillBytes && _compactBytes > _spillThreshold) {
+      spill();
+    }
+    return;
+  }
+
   _ageQueue.insert(cl);
   _weightQueue.insert(cl);
   _size++;
@@ -195,6 +252,9 @@ void AWPassiveClauseContainer::add(Clause* cl)
  * when the Clause is no longer needed by the inference process
  * (i.e. was backward subsumed/simplified), as it can result in
  * deletion of the clause.
+ *
+ * The clauses kept in their compact form are not known outside, so
+ * they are never removed this way.
  */
 void AWPassiveClauseContainer::remove(Clause* cl)
 {
@@ -212,6 +272,176 @@ void AWPassiveClauseContainer::remove(Clause* cl)
   }
 }
 
+/**
+ * True if the first clause of @b queue together with @b compactQueue
+ * is in @b compactQueue.
+ */
+template<class Queue>
+static bool compactFirst(Queue& queue, CompactClauseQueue<Queue>& compactQueue)
+{
+  return !compactQueue.isEmpty() &&
+    (queue.isEmpty() || !queue.lessThan(queue.top(), compactQueue.top()));
+}
+
+/**
+ * True if the first clause of @b queue together with @b compactQueue
+ * has a bucket key at most @b key.
+ */
+template<class Queue>
+static bool firstKeyAtMost(Queue& queue, CompactClauseQueue<Queue>& compactQueue, std::uint64_t key)
+{
+  return (!queue.isEmpty() && queue.bucketKey(queue.top()) <= key) ||
+    (!compactQueue.isEmpty() && queue.bucketKey(compactQueue.top()) <= key);
+}
+
+/**
+ * Return the bucket key of the clause in @b compactQueue after which
+ * the clauses before it take at least @b bytes bytes.
+ */
+template<class Queue>
+static std::uint64_t keyAfterBytes(const Queue& queue, CompactClauseQueue<Queue>& compactQueue, size_t bytes)
+{
+  typename CompactClauseQueue<Queue>::Iterator it(compactQueue);
+  size_t seen = 0;
+  for (;;) {
+    CompactClause* ccl = it.next();
+    seen += ccl->bytes();
+    if (seen >= bytes || !it.hasNext()) {
+      return queue.bucketKey(ccl);
+    }
+  }
+}
+
+/**
+ * Return the bucket key at which the spilled clauses in @b keys (bucket key, bytes)
+ * before it take at least @b bytes bytes. @b keys gets sorted.
+ */
+static std::uint64_t keyAfterBytes(Stack<std::pair<std::uint64_t, size_t>>& keys, size_t bytes)
+{
+  keys.sort();
+  size_t seen = 0;
+  for (const auto& [key, keyBytes] : keys) {
+    seen += keyBytes;
+    if (seen >= bytes) {
+      return key;
+    }
+  }
+  return keys.top().first;
+}
+
+/**
+ * Write to the spill file the compact clauses which are not to be
+ * selected for a long time by either of the queues, and free their memory.
+ *
+ * Each queue keeps in memory its first clauses taking a quarter of _spillBytes:
+ * the spilled clauses have greater bucket keys than the kept ones in both of the
+ * queues. So as long as the first clause of a queue has a bucket key at most
+ * _spillAgeKey or _spillWeightKey, no spilled clause can come before it,
+ * and the clauses are selected in the same order as if none was spilled.
+ *
+ * The next spill comes when the compact clauses grow by a half of _spillBytes
+ * over what is kept, so that it is not repeated while few clauses can go.
+ *
+ * The spilled clauses keep the references to their parents.
+ */
+void AWPassiveClauseContainer::spill()
+{
+  TIME_TRACE("passive clause spilling");
+  ASS_G(_compactSize, 0);
+
+  std::uint64_t ageKey = keyAfterBytes(_ageQueue, _compactAgeQueue, _spillBytes / 4);
+  std::uint64_t weightKey = keyAfterBytes(_weightQueue, _compactWeightQueue, _spillBytes / 4);
+
+  Stack<CompactClause*> toSpill;
+  CompactClauseQueue<AgeQueue>::Iterator it(_compactAgeQueue);
+  while (it.hasNext()) {
+    CompactClause* ccl = it.next();
+    if (_ageQueue.bucketKey(ccl) > ageKey && _weightQueue.bucketKey(ccl) > weightKey) {
+      toSpill.push(ccl);
+    }
+  }
+  for (CompactClause* ccl : toSpill) {
+    // as in popSelected, the removed entries do not look at ccl any more
+    ALWAYS(_compactAgeQueue.remove(ccl));
+    ALWAYS(_compactWeightQueue.remove(ccl));
+    _compactBytes -= ccl->bytes();
+    _spillFile.append(ccl, ccl->bytes());
+    ccl->deallocate();
+  }
+  _compactSize -= toSpill.size();
+  _spilledSize += toSpill.size();
+  env.statistics->spilledPassiveClauses += toSpill.size();
+
+  _spillAgeKey = std::min(_spillAgeKey, ageKey);
+  _spillWeightKey = std::min(_spillWeightKey, weightKey);
+  _spillThreshold = std::max(_spillBytes, _compactBytes + _spillBytes / 2);
+} // AWPassiveClauseContainer::spill
+
+/**
+ * Read back to the compact queues the spilled clauses that come first in either
+ * of the queues: those taking a quarter of _spillBytes by each queue. The others
+ * are written to a new spill file, and the cutoffs move to the keys of the last
+ * clauses read back.
+ */
+void AWPassiveClauseContainer::unspill()
+{
+  TIME_TRACE("passive clause spilling");
+  ASS_G(_spilledSize, 0);
+
+  const char* start = _spillFile.map();
+  const char* end = start + _spillFile.size();
+  // the keys are read from the mapped bytes, a clause is copied only when read back
+  auto spilledAt = [](const char* data) {
+    return reinterpret_cast<CompactClause*>(const_cast<char*>(data));
+  };
+  Stack<std::pair<std::uint64_t, size_t>> ageKeys(_spilledSize);
+  Stack<std::pair<std::uint64_t, size_t>> weightKeys(_spilledSize);
+  for (const char* data = start; data != end; data += spilledAt(data)->bytes()) {
+    CompactClause* spilled = spilledAt(data);
+    ageKeys.push(std::make_pair(_ageQueue.bucketKey(spilled), spilled->bytes()));
+    weightKeys.push(std::make_pair(_weightQueue.bucketKey(spilled), spilled->bytes()));
+  }
+  std::uint64_t ageKey = keyAfterBytes(ageKeys, _spillBytes / 4);
+  std::uint64_t weightKey = keyAfterBytes(weightKeys, _spillBytes / 4);
+
+  unsigned kept = 0;
+  for (const char* data = start; data != end; data += spilledAt(data)->bytes()) {
+    CompactClause* spilled = spilledAt(data);
+    if (_ageQueue.bucketKey(spilled) > ageKey && _weightQueue.bucketKey(spilled) > weightKey) {
+      _keptSpillFile.append(data, spilled->bytes());
+      kept++;
+      continue;
+    }
+    CompactClause* ccl = CompactClause::fromBytes(data);
+    _compactAgeQueue.insert(ccl);
+    _compactWeightQueue.insert(ccl);
+    _compactBytes += ccl->bytes();
+  }
+  _spillFile.clear();
+  _spillFile.swap(_keptSpillFile);
+  _compactSize += _spilledSize - kept;
+  _spilledSize = kept;
+  if (kept) {
+    _spillAgeKey = ageKey;
+    _spillWeightKey = weightKey;
+  } else {
+    _spillAgeKey = UINT64_MAX;
+    _spillWeightKey = UINT64_MAX;
+  }
+  _spillThreshold = std::max(_spillBytes, _compactBytes + _spillBytes / 2);
+} // AWPassiveClauseContainer::unspill
+
+/**
+ * Construct the selected clause from its compact form @b ccl.
+ */
+static Clause* materialize(CompactClause* ccl)
+{
+  Clause* cl = ccl->materialize();
+  cl->incRefCnt(); // see RETAINED_REFERENCES
+  cl->setStore(Clause::PASSIVE);
+  return cl;
+}
+
 bool AWPassiveClauseContainer::byWeight(int balance)
 {
   if (balance > 0) {
@@ -240,14 +470,39 @@ Clause* AWPassiveClauseContainer::popSelected()
     // the deterministic way
     byWeight(_balance);
 
+  if (_spilledSize && !(selByWeight ?
+      firstKeyAtMost(_weightQueue, _compactWeightQueue, _spillWeightKey) :
+      firstKeyAtMost(_ageQueue, _compactAgeQueue, _spillAgeKey))) {
+    // a spilled clause may come first
+    unspill();
+  }
+
   if (selByWeight) {
     _balance -= _ageRatio;
-    cl = _weightQueue.pop();
-    _ageQueue.remove(cl);
+    if (compactFirst(_weightQueue, _compactWeightQueue)) {
+      CompactClause* ccl = _compactWeightQueue.pop();
+      // the entry left in the bucket of the other queue is only marked as removed
+      // and never looked at again, so ccl can be freed when materialized
+      ALWAYS(_compactAgeQueue.remove(ccl));
+      _compactSize--;
+      _compactBytes -= ccl->bytes();
+      cl = materialize(ccl);
+    } else {
+      cl = _weightQueue.pop();
+      _ageQueue.remove(cl);
+    }
   } else {
     _balance += _weightRatio;
-    cl = _ageQueue.pop();
-    _weightQueue.remove(cl);
+    if (compactFirst(_ageQueue, _compactAgeQueue)) {
+      CompactClause* ccl = _compactAgeQueue.pop();
+      ALWAYS(_compactWeightQueue.remove(ccl));
+      _compactSize--;
+      _compactBytes -= ccl->bytes();
+      cl = materialize(ccl);
+    } else {
+      cl = _ageQueue.pop();
+      _weightQueue.remove(cl);
+    }
   }
 
   if (_isOutermost) {
@@ -269,7 +524,7 @@ void AWPassiveClauseContainer::onLimitsUpdated()
   //(unless one of _ageRation or _weightRatio is equal to 0)
 
   static Stack<Clause*> toRemove(256);
-  ClauseQueue::Iterator wit(_weightQueue);
+  WeightQueue::Iterator wit(_weightQueue);
   while (wit.hasNext()) {
     Clause* cl=wit.next();
     if (exceedsAllLimits(cl)) {
@@ -298,10 +553,10 @@ void AWPassiveClauseContainer::simulationInit()
   _simulationBalance = _balance;
 
   // initialize iterators
-  _simulationCurrAgeIt = ClauseQueue::Iterator(_ageQueue);
+  _simulationCurrAgeIt = AgeQueue::Iterator(_ageQueue);
   _simulationCurrAgeCl = _simulationCurrAgeIt.hasNext() ? _simulationCurrAgeIt.next() : nullptr;
 
-  _simulationCurrWeightIt = ClauseQueue::Iterator(_weightQueue);
+  _simulationCurrWeightIt = WeightQueue::Iterator(_weightQueue);
   _simulationCurrWeightCl = _simulationCurrWeightIt.hasNext() ? _simulationCurrWeightIt.next() : nullptr;
 
   // have to consider two possibilities for simulation:
@@ -23,18 +23,20 @@
 #include "Lib/Comparison.hpp"
 #include "Kernel/Clause.hpp"
 #include "Kernel/Term.hpp"
-#include "Kernel/ClauseQueue.hpp"
+#include "Kernel/BucketClauseQueue.hpp"
+#include "Kernel/CompactClause.hpp"
 #include "ClauseContainer.hpp"
 #include "AbstractPassiveClauseContainers.hpp"
 
 #include "Lib/Allocator.hpp"
+#include "Lib/Sys/SpillFile.hpp"
 
 namespace Saturation {
 
 using namespace Kernel;
 
 class AgeQueue
-: public ClauseQueue
+: public BucketClauseQueue<AgeQueue>
 {
 public:
   AgeQueue(const Options& opt) : _opt(opt) {}
@@ -42,25 +44,48 @@ public:
   typedef std::pair<unsigned,unsigned> OrdVal;
   static constexpr OrdVal maxOrdVal = std::make_pair(UINT_MAX,UINT_MAX);
   OrdVal getOrdVal(Clause* cl) const;
-protected:
-  virtual bool lessThan(Clause*,Clause*);
+
+  template<class C>
+  std::uint64_t bucketKey(C* cl) const;
+  template<class C>
+  std::uint64_t entryKey(C* cl) const;
 private:
   const Shell::Options& _opt;
 };
 
 class WeightQueue
-  : public ClauseQueue
+  : public BucketClauseQueue<WeightQueue>
 {
 public:
-  WeightQueue(const Options& opt) : _opt(opt) {}
+  WeightQueue(const Options& opt);
 
   typedef std::pair<unsigned,unsigned> OrdVal;
   static constexpr OrdVal maxOrdVal = std::make_pair(UINT_MAX,UINT_MAX);
   OrdVal getOrdVal(Clause* cl) const;
-protected:
-  virtual bool lessThan(Clause*,Clause*);
+
+  template<class C>
+  std::uint64_t bucketKey(C* cl) const;
+  template<class C>
+  std::uint64_t entryKey(C* cl) const;
 private:
   const Shell::Options& _opt;
+  bool _prioritiseLongReductions;
+};
+
+/**
+ * The compact clauses in the order of the queue @b Queue
+ */
+template<class Queue>
+class CompactClauseQueue
+  : public BucketClauseQueue<CompactClauseQueue<Queue>, CompactClause>
+{
+public:
+  CompactClauseQueue(const Queue& order) : _order(order) {}
+
+  std::uint64_t bucketKey(CompactClause* cl) const { return _order.bucketKey(cl); }
+  std::uint64_t entryKey(CompactClause* cl) const { return _order.entryKey(cl); }
+private:
+  const Queue& _order;
 };
 
 class AgeBasedPassiveClauseContainer
@@ -172,15 +197,44 @@ public:
   Clause* popSelected() override;
   /** True if there are no passive clauses */
   bool isEmpty() const override
-  { return _ageQueue.isEmpty() && _weightQueue.isEmpty(); }
+  { return _ageQueue.isEmpty() && _weightQueue.isEmpty() && _compactAgeQueue.isEmpty() && _spilledSize == 0; }
 
   unsigned sizeEstimate() const override { return _size; }
 
+  bool compactsClauses() const override { return _compact; }
+
 private:
   /** The age queue */
   AgeQueue _ageQueue;
   /** The weight queue */
   WeightQueue _weightQueue;
+  /** The age queue of the clauses kept in their compact form */
+  CompactClauseQueue<AgeQueue> _compactAgeQueue;
+  /** The weight queue of the clauses kept in their compact form */
+  CompactClauseQueue<WeightQueue> _compactWeightQueue;
+  /** If true, the clauses that can be are kept in their compact form, see CompactClause */
+  bool _compact;
+  /** The number of the compact clauses in memory */
+  unsigned _compactSize;
+  /** The bytes taken by the compact clauses in memory */
+  size_t _compactBytes;
+
+  void spill();
+  void unspill();
+
+  /** The compact clauses that were written to disk, see spill() */
+  Lib::Sys::SpillFile _spillFile;
+  /** Where unspill() writes the clauses it does not read back */
+  Lib::Sys::SpillFile _keptSpillFile;
+  /** The number of the clauses in _spillFile */
+  unsigned _spilledSize;
+  /** All the spilled clauses have greater age and weight bucket keys than these */
+  std::uint64_t _spillAgeKey;
+  std::uint64_t _spillWeightKey;
+  /** The bytes the compact clauses in memory should stay around; 0 means never spill */
+  size_t _spillBytes;
+  /** When the compact clauses in memory take more bytes than this, some are spilled */
+  size_t _spillThreshold;
   /** the age ratio */
   int _ageRatio;
   /** the weight ratio */
@@ -209,8 +263,8 @@ private:
   bool setLimits(unsigned newAgeSelectionMaxAge, unsigned newAgeSelectionMaxWeight, unsigned newWeightSelectionMaxWeight);
 
   int _simulationBalance;
-  ClauseQueue::Iterator _simulationCurrAgeIt;
-  ClauseQueue::Iterator _simulationCurrWeightIt;
+  AgeQueue::Iterator _simulationCurrAgeIt;
+  WeightQueue::Iterator _simulationCurrWeightIt;
   Clause* _simulationCurrAgeCl;
   Clause* _simulationCurrWeightCl;
 
@@ -25,7 +25,6 @@
 #include "Shell/Statistics.hpp"
 
 #include "Kernel/Clause.hpp"
-#include "Kernel/ClauseQueue.hpp"
 
 namespace Saturation {
 
@@ -42,7 +41,7 @@ public:
     : PassiveClauseContainer(isOutermost, opt, name), _queue(opt), _size(0), _simulationIt(_queue) {}
 
   ~SingleQueuePassiveClauseContainer() {
-    ClauseQueue::Iterator cit(_queue);
+    typename T::Iterator cit(_queue);
     while (cit.hasNext()) {
       Clause* cl=cit.next();
       ASS(!_isOutermost || cl->store()==Clause::PASSIVE);
@@ -90,7 +89,7 @@ public:
    * LRS specific methods and fields for computation of Limits
    */
 protected:
-  ClauseQueue::Iterator _simulationIt;
+  typename T::Iterator _simulationIt;
   static constexpr typename T::OrdVal MAX_LIMIT = T::maxOrdVal;
   typename T::OrdVal _curLimit = MAX_LIMIT;
 
@@ -105,7 +104,7 @@ protected:
 
 public:
   void simulationInit() override {
-    _simulationIt = ClauseQueue::Iterator(_queue);
+    _simulationIt = typename T::Iterator(_queue);
   }
 
   bool simulationHasNext() override {
@@ -143,6 +143,12 @@ public:
 
   virtual unsigned sizeEstimate() const = 0;
 
+  /**
+   * True if the container may replace the clauses added by their compact form,
+   * after which they must not be accessed, see CompactClause
+   */
+  virtual bool compactsClauses() const { return false; }
+
   /*
    * LRS specific methods for computation of Limits
    */
@@ -29,7 +29,11 @@ class Discount
 {
 public:
   Discount(Problem& prb, const Options& opt)
-    : SaturationAlgorithm(prb, opt) {}
+    : SaturationAlgorithm(prb, opt)
+  {
+    // our simplifying clauses are the active ones, which stay put while new clauses are processed
+    _batchedForwardSimplification = opt.batchedForwardSimplification();
+  }
 
   ClauseContainer* getSimplifyingClauseContainer();
 
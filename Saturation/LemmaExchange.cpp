@@ -0,0 +1,265 @@
+/*
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ */
+/**
+ * @file LemmaExchange.cpp
+ * Implements class LemmaExchange.
+ */
+
+#include <algorithm>
+#include <new>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#include "Lib/Environment.hpp"
+
+#include "Kernel/Clause.hpp"
+#include "Kernel/Inference.hpp"
+#include "Kernel/Signature.hpp"
+#include "Kernel/SortHelper.hpp"
+
+#include "LemmaExchange.hpp"
+
+namespace Saturation {
+
+LemmaExchange* LemmaExchange::s_instance = nullptr;
+
+LemmaExchange::LemmaExchange(Ring* ring)
+  : _ring(ring), _next(0),
+    _functions(env.signature->functions()),
+    _predicates(env.signature->predicates()),
+    _typeCons(env.signature->typeCons())
+{
+}
+
+bool LemmaExchange::create()
+{
+  ASS(!s_instance);
+
+  void* mem = mmap(nullptr, sizeof(Ring), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+  if (mem == MAP_FAILED) {
+    return false;
+  }
+  // the mapping is zero-filled, which is what the slots need, but let's construct the counters properly
+  Ring* ring = static_cast<Ring*>(mem);
+  new (&ring->next) std::atomic<uint64_t>(0);
+  for (Slot& slot : ring->slots) {
+    new (&slot.seq) std::atomic<uint64_t>(0);
+  }
+
+  s_instance = new LemmaExchange(ring);
+  return true;
+}
+
+/**
+ * Is @b cl a lemma worth sending to the other workers?
+ * (Cheap checks only, the encoding may still fail.)
+ */
+bool LemmaExchange::suitable(Clause* cl)
+{
+  return cl->length() == 1
+    && cl->age() > 0 // everybody has their own input
+    && cl->weight() <= MAX_WEIGHT
+    && cl->noSplits()
+    && cl->color() == COLOR_TRANSPARENT
+    && cl->inference().rule() != InferenceRule::IMPORTED_LEMMA;
+}
+
+void LemmaExchange::exportClause(Clause* cl)
+{
+  if (!suitable(cl)) {
+    return;
+  }
+
+  unsigned buffer[SLOT_WORDS];
+  Words words { buffer, 0 };
+  for (unsigned i = 0; i < cl->length(); i++) {
+    if (!encodeLiteral((*cl)[i], words)) {
+      return;
+    }
+  }
+
+  uint64_t index = _ring->next.fetch_add(1, std::memory_order_relaxed);
+  Slot& slot = _ring->slots[index % SLOT_COUNT];
+  slot.seq.store(0, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  slot.exporter = getpid();
+  slot.inputType = static_cast<unsigned>(cl->inputType());
+  slot.length = words.length;
+  std::copy(buffer, buffer + words.length, slot.words);
+  slot.seq.store(index + 1, std::memory_order_release);
+}
+
+void LemmaExchange::importClauses(Stack<Clause*>& out)
+{
+  uint64_t end = _ring->next.load(std::memory_order_acquire);
+  if (end - _next > SLOT_COUNT) {
+    // too far behind, the older lemmas have been overwritten already
+    _next = end - SLOT_COUNT;
+  }
+
+  pid_t self = getpid();
+  unsigned buffer[SLOT_WORDS];
+  for (; _next < end; _next++) {
+    Slot& slot = _ring->slots[_next % SLOT_COUNT];
+    // a slot which is not (or no longer) holding lemma _next gets skipped,
+    // we do not wait for a writer which might never finish
+    if (slot.seq.load(std::memory_order_acquire) != _next + 1) {
+      continue;
+    }
+    pid_t exporter = slot.exporter;
+    UnitInputType inputType = static_cast<UnitInputType>(slot.inputType);
+    unsigned length = std::min(slot.length, SLOT_WORDS);
+    std::copy(slot.words, slot.words + length, buffer);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.seq.load(std::memory_order_relaxed) != _next + 1 || exporter == self) {
+      continue;
+    }
+
+    Clause* cl = decode(buffer, length, inputType);
+    if (cl) {
+      out.push(cl);
+    }
+  }
+}
+
+/**
+ * Append the encoding of @b t to @b out: a variable becomes an odd number,
+ * a term its even-doubled functor followed by the encodings of its arguments.
+ * Whether the functor is a function symbol or a type constructor is given by @b sort.
+ */
+bool LemmaExchange::encodeTerm(TermList t, bool sort, Words& out)
+{
+  if (t.isOrdinaryVar()) {
+    return out.push(2 * t.var() + 1);
+  }
+  if (t.isVar()) {
+    return false;
+  }
+  Term* trm = t.term();
+  if (trm->isSpecial() || trm->functor() >= (sort ? _typeCons : _functions)) {
+    return false;
+  }
+  if (!out.push(2 * trm->functor())) {
+    return false;
+  }
+  unsigned typeArgs = sort ? trm->arity() : env.signature->getFunction(trm->functor())->numTypeArguments();
+  for (unsigned i = 0; i < trm->arity(); i++) {
+    if (!encodeTerm(*trm->nthArgument(i), i < typeArgs, out)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Append the encoding of @b lit to @b out: the doubled predicate plus the polarity,
+ * followed by the sort for equalities, and the arguments.
+ */
+bool LemmaExchange::encodeLiteral(Literal* lit, Words& out)
+{
+  if (lit->functor() >= _predicates || !out.push(2 * lit->functor() + lit->polarity())) {
+    return false;
+  }
+  if (lit->isEquality()) {
+    return encodeTerm(SortHelper::getEqualityArgumentSort(lit), true, out)
+      && encodeTerm(*lit->nthArgument(0), false, out)
+      && encodeTerm(*lit->nthArgument(1), false, out);
+  }
+  unsigned typeArgs = env.signature->getPredicate(lit->functor())->numTypeArguments();
+  for (unsigned i = 0; i < lit->arity(); i++) {
+    if (!encodeTerm(*lit->nthArgument(i), i < typeArgs, out)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool LemmaExchange::decodeTerm(const unsigned*& pos, const unsigned* end, bool sort, TermList& res)
+{
+  if (pos == end) {
+    return false;
+  }
+  unsigned w = *pos++;
+  if (w % 2) {
+    res = TermList::var(w / 2);
+    return true;
+  }
+
+  unsigned functor = w / 2;
+  if (functor >= (sort ? _typeCons : _functions)) {
+    return false;
+  }
+  Signature::Symbol* sym = sort ? env.signature->getTypeCon(functor) : env.signature->getFunction(functor);
+  unsigned typeArgs = sort ? sym->arity() : sym->numTypeArguments();
+  Stack<TermList> args(sym->arity());
+  for (unsigned i = 0; i < sym->arity(); i++) {
+    TermList arg;
+    if (!decodeTerm(pos, end, i < typeArgs, arg)) {
+      return false;
+    }
+    args.push(arg);
+  }
+  res = sort ? TermList(AtomicSort::create(functor, args.length(), args.begin()))
+             : TermList(Term::create(functor, args));
+  return true;
+}
+
+Literal* LemmaExchange::decodeLiteral(const unsigned*& pos, const unsigned* end)
+{
+  if (pos == end) {
+    return nullptr;
+  }
+  unsigned w = *pos++;
+  unsigned pred = w / 2;
+  bool polarity = w % 2;
+  if (pred >= _predicates) {
+    return nullptr;
+  }
+
+  if (pred == 0) {
+    TermList sort, lhs, rhs;
+    if (!decodeTerm(pos, end, true, sort) || !decodeTerm(pos, end, false, lhs) || !decodeTerm(pos, end, false, rhs)) {
+      return nullptr;
+    }
+    return Literal::createEquality(polarity, lhs, rhs, sort);
+  }
+
+  Signature::Symbol* sym = env.signature->getPredicate(pred);
+  unsigned typeArgs = sym->numTypeArguments();
+  Stack<TermList> args(sym->arity());
+  for (unsigned i = 0; i < sym->arity(); i++) {
+    TermList arg;
+    if (!decodeTerm(pos, end, i < typeArgs, arg)) {
+      return nullptr;
+    }
+    args.push(arg);
+  }
+  return Literal::create(pred, args.length(), polarity, args.begin());
+}
+
+Clause* LemmaExchange::decode(const unsigned* words, unsigned length, UnitInputType inputType)
+{
+  const unsigned* pos = words;
+  const unsigned* end = words + length;
+  Stack<Literal*> lits;
+  while (pos != end) {
+    Literal* lit = decodeLiteral(pos, end);
+    if (!lit) {
+      return nullptr;
+    }
+    lits.push(lit);
+  }
+  if (lits.isEmpty()) {
+    return nullptr;
+  }
+  return Clause::fromStack(lits, NonspecificInference0(inputType, InferenceRule::IMPORTED_LEMMA));
+}
+
+}
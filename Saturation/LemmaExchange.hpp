@@ -0,0 +1,118 @@
+/*
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ */
+/**
+ * @file LemmaExchange.hpp
+ * Defines class LemmaExchange.
+ */
+
+#ifndef __LemmaExchange__
+#define __LemmaExchange__
+
+#include <atomic>
+#include <cstdint>
+#include <sys/types.h>
+
+#include "Forwards.hpp"
+#include "Lib/Stack.hpp"
+#include "Kernel/Term.hpp"
+
+namespace Saturation {
+
+using namespace Lib;
+using namespace Kernel;
+
+/**
+ * A channel through which the workers of the portfolio mode pass
+ * small derived clauses to each other.
+ *
+ * The lemmas are stored in a ring buffer in memory shared by all the processes
+ * forked after @b create() was called. Writers never wait: a lemma which gets overwritten
+ * before some reader gets to it is simply lost for that reader.
+ *
+ * Lemmas are transferred as sequences of symbol numbers, so only lemmas
+ * over the symbols that existed when the channel was created
+ * (and which therefore mean the same in all workers) can be exported.
+ * Imported lemmas get the inference rule IMPORTED_LEMMA.
+ */
+class LemmaExchange {
+public:
+  /**
+   * Create the channel, to be inherited by the processes forked from now on.
+   * Return false if that is not possible on this system.
+   */
+  static bool create();
+  /** The channel, or nullptr if there is none */
+  static LemmaExchange* instance() { return s_instance; }
+
+  /** Export @b cl to the other workers, if it is a suitable lemma */
+  void exportClause(Clause* cl);
+  /** Push onto @b out the lemmas exported by the other workers since the last call */
+  void importClauses(Stack<Clause*>& out);
+
+  /** Only unit clauses at most this heavy get exported */
+  static const unsigned MAX_WEIGHT = 20;
+
+private:
+  static const unsigned SLOT_COUNT = 4096;
+  static const unsigned SLOT_WORDS = 60;
+
+  struct Slot {
+    /** one plus the index of the lemma stored in the slot, 0 while it is being written */
+    std::atomic<uint64_t> seq;
+    pid_t exporter;
+    unsigned inputType;
+    unsigned length;
+    unsigned words[SLOT_WORDS];
+  };
+
+  struct Ring {
+    /** index of the next lemma to be exported */
+    std::atomic<uint64_t> next;
+    Slot slots[SLOT_COUNT];
+  };
+  static_assert(std::atomic<uint64_t>::is_always_lock_free, "the ring is shared between processes");
+
+  /** Encoding of a lemma under construction */
+  struct Words {
+    unsigned* data;
+    unsigned length;
+
+    bool push(unsigned w) {
+      if (length == SLOT_WORDS) {
+        return false;
+      }
+      data[length++] = w;
+      return true;
+    }
+  };
+
+  LemmaExchange(Ring* ring);
+
+  bool suitable(Clause* cl);
+  bool encodeTerm(TermList t, bool sort, Words& out);
+  bool encodeLiteral(Literal* lit, Words& out);
+  bool decodeTerm(const unsigned*& pos, const unsigned* end, bool sort, TermList& res);
+  Literal* decodeLiteral(const unsigned*& pos, const unsigned* end);
+  Clause* decode(const unsigned* words, unsigned length, UnitInputType inputType);
+
+  static LemmaExchange* s_instance;
+
+  Ring* _ring;
+  /** index of the next lemma to be imported */
+  uint64_t _next;
+  /** number of function symbols, predicates and type constructors shared by all the workers */
+  unsigned _functions;
+  unsigned _predicates;
+  unsigned _typeCons;
+};
+
+}
+
+#endif // __LemmaExchange__
@@ -18,7 +18,6 @@
 #include <vector>
 #include "Kernel/Clause.hpp"
 #include "ClauseContainer.hpp"
-#include "Kernel/ClauseQueue.hpp"
 
 namespace Saturation {
 
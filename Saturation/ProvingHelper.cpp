@@ -83,26 +83,9 @@ using namespace Shell;
  */
 void ProvingHelper::runVampire(Problem& prb, const Options& opt)
 {
-  // Here officially starts preprocessing of the porfolio mode (separately for each worker)
-  // and that's the moment we want to set the random seed
-  // (no randomness in parsing, for the peace of mind - parsing was done by the master process!)
-  // the main reason being that we want to stay in sync with what vampire mode does
-  // cf getPreprocessedProblem in vampire.cpp
-  if (opt.randomSeed() != 0) {
-    Lib::Random::setSeed(opt.randomSeed());
-  } else {
-    Lib::Random::resetSeed();
-  }
-
   try
   {
-    ClauseIterator clauses;
-    {
-      TIME_TRACE(TimeTrace::PREPROCESSING);
-
-      Preprocess prepro(opt);
-      prepro.preprocess(prb);
-    }
+    runVampirePreprocessing(prb, opt);
     runVampireSaturationImpl(prb, opt);
   }
   catch(const std::bad_alloc &) {
@@ -119,6 +102,31 @@ void ProvingHelper::runVampire(Problem& prb, const Options& opt)
   }
 }
 
+/**
+ * Run the Vampire preprocessing (based on the content of @b opt ) on @b prb,
+ * without the saturation loop that would normally follow it.
+ *
+ * Exceptions are not caught here, it is up to the caller to deal with them.
+ */
+void ProvingHelper::runVampirePreprocessing(Problem& prb, const Options& opt)
+{
+  // Here officially starts preprocessing of the porfolio mode (separately for each worker)
+  // and that's the moment we want to set the random seed
+  // (no randomness in parsing, for the peace of mind - parsing was done by the master process!)
+  // the main reason being that we want to stay in sync with what vampire mode does
+  // cf getPreprocessedProblem in vampire.cpp
+  if (opt.randomSeed() != 0) {
+    Lib::Random::setSeed(opt.randomSeed());
+  } else {
+    Lib::Random::resetSeed();
+  }
+
+  TIME_TRACE(TimeTrace::PREPROCESSING);
+
+  Preprocess prepro(opt);
+  prepro.preprocess(prb);
+}
+
 /**
  * Private version of the @b runVampireSaturation function
  * that is not protected for resource-limit exceptions
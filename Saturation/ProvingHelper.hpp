@@ -26,6 +26,7 @@ class ProvingHelper {
 public:
   static void runVampireSaturation(Problem& prb, const Options& opt);
   static void runVampire(Problem& prb, const Options& opt);
+  static void runVampirePreprocessing(Problem& prb, const Options& opt);
 private:
   static void runVampireSaturationImpl(Problem& prb, const Options& opt);
 };
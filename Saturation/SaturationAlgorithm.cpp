@@ -12,6 +12,8 @@
  * Implementing SaturationAlgorithm class.
  */
 
+#include <sstream>
+
 #include "Debug/Assertion.hpp"
 #include "Debug/RuntimeStatistics.hpp"
 
@@ -72,6 +74,7 @@
 #include "Inferences/FunctionDefinitionRewriting.hpp"
 #include "Inferences/ForwardDemodulation.hpp"
 #include "Inferences/ForwardLiteralRewriting.hpp"
+#include "Inferences/FeatureVectorForwardSubsumptionAndResolution.hpp"
 #include "Inferences/ForwardSubsumptionAndResolution.hpp"
 #include "Inferences/InvalidAnswerLiteralRemovals.hpp"
 #include "Inferences/ForwardSubsumptionDemodulation.hpp"
@@ -108,11 +111,13 @@
 #include "Shell/Statistics.hpp"
 #include "Debug/TimeProfiling.hpp"
 #include "Shell/Shuffling.hpp"
+#include "Shell/UIHelper.hpp"
 
 #include "Splitter.hpp"
 
 #include "ConsequenceFinder.hpp"
 #include "LabelFinder.hpp"
+#include "LemmaExchange.hpp"
 #include "Splitter.hpp"
 #include "SymElOutput.hpp"
 #include "SaturationAlgorithm.hpp"
@@ -231,6 +236,17 @@ SaturationAlgorithm::SaturationAlgorithm(Problem& prb, const Options& opt)
   ASS_EQ(s_instance, 0);  //there can be only one saturation algorithm at a time
 
   _activationLimit = opt.activationLimit();
+  _memoryCompaction = opt.memoryCompaction();
+  _memoryStatistics = opt.memoryStatistics();
+  _indexStatistics = opt.indexStatistics();
+  if (opt.variantFilter()) {
+    _variantIndex = new StoredClauseVariantIndex();
+  }
+
+  // the lemmas would get mixed up with the answer literals
+  if (opt.questionAnswering() == Options::QuestionAnsweringMode::OFF) {
+    _lemmaExchange = LemmaExchange::instance();
+  }
 
   _ordering = OrderingSP(Ordering::create(prb, opt));
   if (!Ordering::trySetGlobalOrdering(_ordering)) {
@@ -249,6 +265,7 @@ SaturationAlgorithm::SaturationAlgorithm(Problem& prb, const Options& opt)
   else {
     _passive = makeLevel4(true, opt, "");
   }
+  _compactPassive = _passive->compactsClauses();
   _active = new ActiveClauseContainer();
 
   _active->attach(this);
@@ -363,7 +380,7 @@ void SaturationAlgorithm::onActiveAdded(Clause* c)
 void SaturationAlgorithm::onActiveRemoved(Clause* c)
 {
   ASS(c->store()==Clause::ACTIVE);
-  c->setStore(Clause::NONE);
+  dropClause(c);
   // at this point the c object may be deleted
 }
 
@@ -406,7 +423,7 @@ void SaturationAlgorithm::onPassiveAdded(Clause* c)
 void SaturationAlgorithm::onPassiveRemoved(Clause* c)
 {
   ASS(c->store()==Clause::PASSIVE);
-  c->setStore(Clause::NONE);
+  dropClause(c);
   // at this point the c object can be deleted
 }
 
@@ -853,12 +870,17 @@ bool SaturationAlgorithm::clausesFlushed()
  * to unprocessed.
  *
  * Forward demodulation is also being performed on @b cl.
+ * If the variant filter is on, variants of the kept clauses are dropped beforehand.
  */
 void SaturationAlgorithm::addUnprocessedClause(Clause* cl)
 {
   _generatedClauseCount++;
   env.statistics->generatedClauses++;
 
+  if (_variantIndex && isVariantDuplicate(cl)) {
+    return;
+  }
+
   cl=doImmediateSimplification(cl);
   if (!cl) {
     return;
@@ -869,9 +891,30 @@ void SaturationAlgorithm::addUnprocessedClause(Clause* cl)
   }
 
   cl->setStore(Clause::UNPROCESSED);
+  if (_variantIndex) {
+    _variantIndex->insert(cl);
+  }
   _unprocessed->add(cl);
 }
 
+/**
+ * Return true (and update the statistics) if a variant of @b cl with the same
+ * splits is already in unprocessed, passive or active.
+ */
+bool SaturationAlgorithm::isVariantDuplicate(Clause* cl)
+{
+  TIME_TRACE("variant filter");
+
+  ClauseIterator variants = _variantIndex->retrieveVariants(cl);
+  while (variants.hasNext()) {
+    if (variants.next()->splits() == cl->splits()) {
+      env.statistics->variantDuplicates++;
+      return true;
+    }
+  }
+  return false;
+}
+
 /**
  * Deal with clause that has an empty non-propositional part.
  *
@@ -913,32 +956,96 @@ bool SaturationAlgorithm::forwardSimplify(Clause* cl)
 {
   TIME_TRACE("forward simplification");
 
-  if (_passive->exceedsAllLimits(cl)) {
-    RSTAT_CTR_INC("clauses discarded by limit in forward simplification");
-    env.statistics->discardedNonRedundantClauses++;
+  if (discardedByLimits(cl)) {
     return false;
   }
 
   FwSimplList::Iterator fsit(_fwSimplifiers);
 
   while (fsit.hasNext()) {
-    ForwardSimplificationEngine *fse = fsit.next();
+    if (forwardSimplifyWith(fsit.next(), cl)) {
+      return false;
+    }
+  }
 
-    {
-      Clause *replacement = 0;
-      ClauseIterator premises = ClauseIterator::getEmpty();
+  return finishForwardSimplification(cl);
+}
 
-      if (fse->perform(cl, replacement, premises)) {
-        if (replacement) {
-          addNewClause(replacement);
-        }
-        onClauseReduction(cl, &replacement, 1, premises);
+/**
+ * Forward simplify the unprocessed clauses in @b batch, engine by engine,
+ * leaving in @b batch only the clauses to be retained (in their original order).
+ *
+ * Equivalent to calling forwardSimplify on each clause of the batch,
+ * provided the simplifying clauses do not change in the meantime.
+ * Each engine then goes through all the clauses in one go,
+ * which keeps its index hot in the cache.
+ */
+void SaturationAlgorithm::forwardSimplify(ClauseStack& batch)
+{
+  TIME_TRACE("forward simplification");
 
-        return false;
+  auto filter = [&](auto retain) {
+    unsigned kept = 0;
+    for (Clause* cl : batch) {
+      if (retain(cl)) {
+        batch[kept++] = cl;
+      } else {
+        ASS_EQ(cl->store(), Clause::UNPROCESSED);
+        dropClause(cl);
       }
     }
+    batch.truncate(kept);
+  };
+
+  filter([&](Clause* cl) { return !discardedByLimits(cl); });
+
+  FwSimplList::Iterator fsit(_fwSimplifiers);
+  while (fsit.hasNext() && batch.isNonEmpty()) {
+    ForwardSimplificationEngine* fse = fsit.next();
+    filter([&](Clause* cl) { return !forwardSimplifyWith(fse, cl); });
   }
 
+  filter([&](Clause* cl) { return finishForwardSimplification(cl); });
+}
+
+/**
+ * Return true (and update the statistics) if @b cl is over the limits of the passive container.
+ */
+bool SaturationAlgorithm::discardedByLimits(Clause* cl)
+{
+  if (_passive->exceedsAllLimits(cl)) {
+    RSTAT_CTR_INC("clauses discarded by limit in forward simplification");
+    env.statistics->discardedNonRedundantClauses++;
+    return true;
+  }
+  return false;
+}
+
+/**
+ * Try to simplify @b cl using the forward simplification engine @b fse.
+ * Return true if @b cl was simplified away (its replacement, if any, has been added as a new clause).
+ */
+bool SaturationAlgorithm::forwardSimplifyWith(ForwardSimplificationEngine* fse, Clause* cl)
+{
+  Clause *replacement = 0;
+  ClauseIterator premises = ClauseIterator::getEmpty();
+
+  if (fse->perform(cl, replacement, premises)) {
+    if (replacement) {
+      addNewClause(replacement);
+    }
+    onClauseReduction(cl, &replacement, 1, premises);
+    return true;
+  }
+  return false;
+}
+
+/**
+ * The part of forward simplification that comes after the forward simplification engines.
+ * Return true if @b cl is to be retained.
+ */
+bool SaturationAlgorithm::finishForwardSimplification(Clause* cl)
+{
   static ClauseStack repStack;
 
   repStack.reset();
@@ -1076,16 +1183,33 @@ void SaturationAlgorithm::addToPassive(Clause* cl)
   cl->setStore(Clause::PASSIVE);
   env.statistics->passiveClauses++;
 
+  if (_compactPassive && _variantIndex && cl->noSplits()) {
+    // the reference from the variant index would keep the clause from its compact form
+    _variantIndex->remove(cl);
+  }
   {
     TIME_TRACE(TimeTrace::PASSIVE_CONTAINER_MAINTENANCE);
     _passive->add(cl);
   }
+  // if the passive clauses are compact, cl may be destroyed by now
 }
 
 void SaturationAlgorithm::removeSelected(Clause* cl)
 {
   ASS_EQ(cl->store(), Clause::SELECTED);
   beforeSelectedRemoved(cl);
+  dropClause(cl);
+}
+
+/**
+ * Set the store of @b cl, which leaves the clause containers for good, to NONE.
+ * The variant index lets go of the clause first, so that it can be deleted.
+ */
+void SaturationAlgorithm::dropClause(Clause* cl)
+{
+  if (_variantIndex) {
+    _variantIndex->remove(cl);
+  }
   cl->setStore(Clause::NONE);
 }
 
@@ -1141,15 +1265,31 @@ void SaturationAlgorithm::activate(Clause* cl)
   env.statistics->activeClauses++;
   _active->add(cl);
 
+  if (_lemmaExchange) {
+    _lemmaExchange->exportClause(cl);
+  }
+
   _partialRedundancyHandler->checkEquations(cl);
 
   auto generated = TIME_TRACE_EXPR(TimeTrace::CLAUSE_GENERATION, _generator->generateSimplify(cl));
-  auto toAdd = TIME_TRACE_ITER(TimeTrace::CLAUSE_GENERATION, generated.clauses);
 
-  while (toAdd.hasNext()) {
-    Clause *genCl = toAdd.next();
+  // first run the generating inferences to completion, only then hand their conclusions over;
+  // the index traversals of the generating inferences are then not interleaved
+  // with the processing of the new clauses, and the engines are free to produce
+  // their conclusions in any way, as long as the order in which they get added stays the same
+  {
+    TIME_TRACE(TimeTrace::CLAUSE_GENERATION);
+    ASS(_generatedBuffer.isEmpty());
+    _generatedBuffer.loadFromIterator(generated.clauses);
+  }
+
+  for (Clause* genCl : _generatedBuffer) {
     addNewClause(genCl);
 
+    if (!_symEl) {
+      // onParenthood would be a no-op
+      continue;
+    }
     Inference::Iterator iit = genCl->inference().iterator();
     while (genCl->inference().hasNext(iit)) {
       Unit *premUnit = genCl->inference().next(iit);
@@ -1162,6 +1302,7 @@ void SaturationAlgorithm::activate(Clause* cl)
       }
     }
   }
+  _generatedBuffer.reset();
 
   _clauseActivationInProgress = false;
 
@@ -1195,6 +1336,10 @@ void SaturationAlgorithm::doUnprocessedLoop()
   do {
     newClausesToUnprocessed();
 
+    if (_batchedForwardSimplification) {
+      doUnprocessedLoopInBatches();
+    }
+
     while (!_unprocessed->isEmpty()) {
       Clause* c = _unprocessed->pop();
       poppedFromUnprocessed(c); // tells LRS's it might make sense to update limits
@@ -1204,11 +1349,11 @@ void SaturationAlgorithm::doUnprocessedLoop()
       if (forwardSimplify(c)) {
         onClauseRetained(c);
         addToPassive(c);
-        ASS_EQ(c->store(), Clause::PASSIVE);
+        ASS(_compactPassive || c->store() == Clause::PASSIVE);
       }
       else {
         ASS_EQ(c->store(), Clause::UNPROCESSED);
-        c->setStore(Clause::NONE);
+        dropClause(c);
       }
 
       newClausesToUnprocessed();
@@ -1219,6 +1364,35 @@ void SaturationAlgorithm::doUnprocessedLoop()
   } while (!clausesFlushed());
 }
 
+/**
+ * Process the unprocessed clauses as doUnprocessedLoop does, but forward simplify them in batches.
+ */
+void SaturationAlgorithm::doUnprocessedLoopInBatches()
+{
+  static ClauseStack batch;
+  batch.reset();
+
+  while (!_unprocessed->isEmpty()) {
+    while (!_unprocessed->isEmpty()) {
+      Clause* c = _unprocessed->pop();
+      poppedFromUnprocessed(c);
+      ASS(!isRefutation(c));
+      batch.push(c);
+    }
+
+    forwardSimplify(batch);
+
+    for (Clause* c : batch) {
+      onClauseRetained(c);
+      addToPassive(c);
+      ASS(_compactPassive || c->store() == Clause::PASSIVE);
+    }
+    batch.reset();
+
+    newClausesToUnprocessed();
+  }
+}
+
 /**
  * Return true if clause can be passed to activation
  *
@@ -1307,6 +1481,30 @@ void SaturationAlgorithm::doOneAlgorithmStep()
   activate(cl);
 }
 
+/**
+ * Add the lemmas which the other portfolio workers have exported since the last call
+ */
+void SaturationAlgorithm::importLemmas()
+{
+  Stack<Clause*> lemmas;
+  _lemmaExchange->importClauses(lemmas);
+  while (lemmas.isNonEmpty()) {
+    addNewClause(lemmas.pop());
+  }
+}
+
+/**
+ * Defragment the memory freed by the deleted clauses and terms, see Lib::compactAllocations
+ */
+void SaturationAlgorithm::compactMemory()
+{
+  TIME_TRACE("memory compaction");
+
+  bool release = _memoryCompaction == Options::MemoryCompaction::RELEASE;
+  Clause::compactAllocator(release);
+  Lib::compactAllocations(release);
+}
+
 /**
  * Perform saturation on clauses that were added through
  * @b addInputClauses function
@@ -1320,6 +1518,24 @@ MainLoopResult SaturationAlgorithm::runImpl()
     while (true) {
       doOneAlgorithmStep(); // will bump env.statistics->activations by one
 
+      if (UIHelper::progressReportFd >= 0) {
+        UIHelper::reportProgress();
+      }
+      if (_lemmaExchange) {
+        importLemmas();
+      }
+      if (_memoryCompaction != Options::MemoryCompaction::OFF
+          && env.statistics->activations % MEMORY_COMPACTION_INTERVAL == 0) {
+        compactMemory();
+      }
+      if (_memoryStatistics && env.statistics->activations % _memoryStatistics == 0) {
+        env.statistics->printMemory(std::cout);
+      }
+      if (_indexStatistics && env.statistics->activations % _indexStatistics == 0) {
+        std::ostringstream report;
+        _imgr->printStatistics(report);
+        Statistics::printCommented(std::cout, report.str());
+      }
       if (_activationLimit && env.statistics->activations > _activationLimit) {
         throw ActivationLimitExceededException();
       }
@@ -1329,6 +1545,12 @@ MainLoopResult SaturationAlgorithm::runImpl()
   }
   catch (ThrowableBase&) {
     tryUpdateFinalClauseCount();
+    if (_indexStatistics) {
+      // printed by Statistics::print, after the indices are gone
+      std::ostringstream report;
+      _imgr->printStatistics(report);
+      env.statistics->finalIndexStatistics = report.str();
+    }
     throw;
   }
 }
@@ -1676,7 +1898,9 @@ SaturationAlgorithm *SaturationAlgorithm::createFromOptions(Problem& prb, const
   }
 
   if (opt.forwardSubsumption()) {
-    if (opt.codeTreeSubsumption()) {
+    if (opt.featureVectorSubsumption() != Options::FeatureVectorSubsumption::OFF) {
+      res->addForwardSimplifierToFront(new FeatureVectorForwardSubsumptionAndResolution(opt.forwardSubsumptionResolution()));
+    } else if (opt.codeTreeSubsumption()) {
       res->addForwardSimplifierToFront(new CodeTreeForwardSubsumptionAndResolution(opt.forwardSubsumptionResolution()));
     } else {
       res->addForwardSimplifierToFront(new ForwardSubsumptionAndResolution(opt.forwardSubsumptionResolution()));
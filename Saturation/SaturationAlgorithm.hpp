@@ -27,6 +27,7 @@
 #include "Kernel/MainLoop.hpp"
 #include "Kernel/RCClauseStack.hpp"
 
+#include "Indexing/ClauseVariantIndex.hpp"
 #include "Indexing/IndexManager.hpp"
 
 #include "Inferences/InferenceEngine.hpp"
@@ -54,6 +55,7 @@ class ConsequenceFinder;
 class LabelFinder;
 class SymElOutput;
 class Splitter;
+class LemmaExchange;
 
 class SaturationAlgorithm : public MainLoop
 {
@@ -147,16 +149,23 @@ protected:
   virtual void init();
   virtual MainLoopResult runImpl();
   void doUnprocessedLoop();
+  void doUnprocessedLoopInBatches();
   virtual bool handleClauseBeforeActivation(Clause* c);
   void addInputSOSClause(Clause* cl);
 
   void newClausesToUnprocessed();
   void addUnprocessedClause(Clause* cl);
+  bool isVariantDuplicate(Clause* cl);
   bool forwardSimplify(Clause* c);
+  void forwardSimplify(ClauseStack& batch);
+  bool discardedByLimits(Clause* c);
+  bool forwardSimplifyWith(ForwardSimplificationEngine* fse, Clause* c);
+  bool finishForwardSimplification(Clause* c);
   void backwardSimplify(Clause* c);
   void addToPassive(Clause* c);
   void activate(Clause* c);
   void removeSelected(Clause*);
+  void dropClause(Clause* cl);
   virtual void onSOSClauseAdded(Clause* c) {}
   void onActiveAdded(Clause* c);
   virtual void onActiveRemoved(Clause* c);
@@ -175,6 +184,8 @@ private:
   void passiveRemovedHandler(Clause* cl);
   void activeRemovedHandler(Clause* cl);
   void addInputClause(Clause* cl);
+  void importLemmas();
+  void compactMemory();
 
   LiteralSelector& getSosLiteralSelector();
 
@@ -249,12 +260,35 @@ protected:
   /** Number of clauses that entered the unprocessed container */
   unsigned _generatedClauseCount;
   unsigned _activationLimit;
+
+  /** Forward simplify the unprocessed clauses in batches; only to be set
+   * when the simplifying clauses do not change during doUnprocessedLoop */
+  bool _batchedForwardSimplification = false;
 private:
   static CompositeISE* createISE(Problem& prb, const Options& opt, Ordering& ordering,
      bool alascaTakesOver);
 
   // a "soft" time limit in deciseconds, checked manually: 0 is no limit
   unsigned _softTimeLimit = 0;
+
+  // what to do with the free memory every MEMORY_COMPACTION_INTERVAL activations
+  Options::MemoryCompaction _memoryCompaction;
+  static const unsigned MEMORY_COMPACTION_INTERVAL = 10000;
+  // print the memory statistics every this many activations, if not 0
+  unsigned _memoryStatistics;
+  // print the index statistics every this many activations, if not 0
+  unsigned _indexStatistics;
+
+  // the channel to the other portfolio workers, if we are to use one
+  LemmaExchange* _lemmaExchange = nullptr;
+
+  // conclusions of the generating inferences with the clause being activated, see activate()
+  Stack<Clause*> _generatedBuffer;
+
+  // the clauses in unprocessed, passive and active, if the new clauses are to be checked for variants
+  ScopedPtr<StoredClauseVariantIndex> _variantIndex;
+  // the passive container keeps the clauses in their compact form, see CompactClause
+  bool _compactPassive;
 };
 
 
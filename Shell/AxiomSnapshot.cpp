@@ -0,0 +1,366 @@
+/*
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ */
+/**
+ * @file AxiomSnapshot.cpp
+ * Implements class AxiomSnapshot.
+ *
+ * The file is a sequence of 32-bit words: a header, the type constructors,
+ * the function and the predicate symbols, and the clauses. Symbols are referred to
+ * by their positions in these tables. A term is written in prefix order, a variable
+ * as (number << 1) | 1 and a symbol application as (symbol << 1) followed by its arguments.
+ */
+
+#include <cstring>
+#include <fstream>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "Kernel/Clause.hpp"
+#include "Kernel/Inference.hpp"
+#include "Kernel/OperatorType.hpp"
+#include "Kernel/Signature.hpp"
+#include "Kernel/SortHelper.hpp"
+#include "Kernel/Term.hpp"
+
+#include "Lib/Environment.hpp"
+#include "Lib/Exception.hpp"
+#include "Lib/Recycled.hpp"
+
+#include "AxiomSnapshot.hpp"
+
+namespace Shell {
+
+static const unsigned SNAPSHOT_MAGIC = 0x504e5356; // "VSNP"
+static const unsigned SNAPSHOT_VERSION = 1;
+
+enum SymbolFlags : unsigned {
+  INTRODUCED = 1,
+  SKOLEM = 2,
+  SKIP = 4
+};
+
+static Signature::Symbol* getSymbol(unsigned kind, unsigned symbol)
+{
+  switch (kind) {
+    case 0: return env.signature->getTypeCon(symbol);
+    case 1: return env.signature->getFunction(symbol);
+    default: return env.signature->getPredicate(symbol);
+  }
+}
+
+static void writeString(Stack<unsigned>& out, const std::string& str)
+{
+  out.push(str.size());
+  for (unsigned i = 0; i < str.size(); i += sizeof(unsigned)) {
+    unsigned word = 0;
+    memcpy(&word, str.data() + i, std::min<size_t>(sizeof(unsigned), str.size() - i));
+    out.push(word);
+  }
+}
+
+unsigned AxiomSnapshot::localSymbol(SymbolKind kind, unsigned symbol)
+{
+  unsigned* local;
+  if (_localSymbols[kind].getValuePtr(symbol, local)) {
+    Signature::Symbol* sym = getSymbol(kind, symbol);
+    if (kind != TYPE_CON && (sym->interpreted() || sym->numTypeArguments() > 0)) {
+      USER_ERROR("Cannot save symbol " + sym->name() + " to an axiom snapshot: "
+                 "interpreted and polymorphic symbols are not supported");
+    }
+    *local = _symbols[kind].size();
+    _symbols[kind].push(symbol);
+  }
+  return *local;
+}
+
+void AxiomSnapshot::writeSort(TermList sort)
+{
+  if (sort.isVar()) {
+    USER_ERROR("Cannot save sort " + sort.toString() + " to an axiom snapshot: polymorphism is not supported");
+  }
+  Term* t = sort.term();
+  _words.push(localSymbol(TYPE_CON, t->functor()) << 1);
+  for (unsigned i = 0; i < t->arity(); i++) {
+    writeSort(*t->nthArgument(i));
+  }
+}
+
+void AxiomSnapshot::writeTerm(TermList t)
+{
+  if (t.isVar()) {
+    _words.push((t.var() << 1) | 1);
+    return;
+  }
+  Term* trm = t.term();
+  if (trm->isSpecial() || trm->isSort()) {
+    USER_ERROR("Cannot save term " + t.toString() + " to an axiom snapshot");
+  }
+  _words.push(localSymbol(FUNCTION, trm->functor()) << 1);
+  for (unsigned i = 0; i < trm->arity(); i++) {
+    writeTerm(*trm->nthArgument(i));
+  }
+}
+
+void AxiomSnapshot::writeLiteral(Literal* lit)
+{
+  // the predicate, the polarity and whether it is an equality
+  if (lit->isEquality()) {
+    _words.push((lit->polarity() << 1) | 1);
+    writeSort(SortHelper::getEqualityArgumentSort(lit));
+  } else {
+    _words.push((localSymbol(PREDICATE, lit->functor()) << 2) | (lit->polarity() << 1));
+  }
+  for (unsigned i = 0; i < lit->arity(); i++) {
+    writeTerm(*lit->nthArgument(i));
+  }
+}
+
+void AxiomSnapshot::save(const std::string& fileName, ClauseIterator clauses)
+{
+  AxiomSnapshot snapshot;
+
+  unsigned clauseCount = 0;
+  for (Clause* cl : iterTraits(clauses)) {
+    snapshot._words.push(static_cast<unsigned>(cl->inputType()));
+    snapshot._words.push(cl->length());
+    for (Literal* lit : cl->iterLits()) {
+      snapshot.writeLiteral(lit);
+    }
+    clauseCount++;
+  }
+  Stack<unsigned> clauseWords = std::move(snapshot._words);
+
+  // function and predicate symbols with their types, which may add more type constructors
+  snapshot._words.reset();
+  for (unsigned kind : { FUNCTION, PREDICATE }) {
+    snapshot._words.push(snapshot._symbols[kind].size());
+    for (unsigned symbol : snapshot._symbols[kind]) {
+      Signature::Symbol* sym = getSymbol(kind, symbol);
+      OperatorType* type = kind == FUNCTION ? sym->fnType() : sym->predType();
+      writeString(snapshot._words, sym->name());
+      snapshot._words.push(sym->arity());
+      snapshot._words.push((sym->introduced() ? INTRODUCED : 0) | (sym->skolem() ? SKOLEM : 0) | (sym->skip() ? SKIP : 0));
+      for (unsigned i = 0; i < sym->arity(); i++) {
+        snapshot.writeSort(type->arg(i));
+      }
+      if (kind == FUNCTION) {
+        snapshot.writeSort(type->result());
+      }
+    }
+  }
+  Stack<unsigned> symbolWords = std::move(snapshot._words);
+
+  Stack<unsigned> header;
+  header.push(SNAPSHOT_MAGIC);
+  header.push(SNAPSHOT_VERSION);
+  header.push(snapshot._symbols[TYPE_CON].size());
+  for (unsigned typeCon : snapshot._symbols[TYPE_CON]) {
+    Signature::Symbol* sym = env.signature->getTypeCon(typeCon);
+    writeString(header, sym->name());
+    header.push(sym->arity());
+  }
+  header.push(clauseCount);
+
+  std::ofstream out(fileName, std::ios::binary);
+  for (Stack<unsigned>* words : { &header, &symbolWords, &clauseWords }) {
+    out.write(reinterpret_cast<const char*>(words->begin()), words->size() * sizeof(unsigned));
+  }
+  if (out.fail()) {
+    USER_ERROR("Cannot write axiom snapshot " + fileName);
+  }
+}
+
+/**
+ * Reading the words of a mapped snapshot file.
+ */
+class SnapshotReader
+{
+public:
+  SnapshotReader(const std::string& fileName, const unsigned* begin, const unsigned* end)
+    : _fileName(fileName), _pos(begin), _end(end) {}
+
+  unsigned next()
+  {
+    if (_pos == _end) {
+      USER_ERROR("Axiom snapshot " + _fileName + " is truncated");
+    }
+    return *_pos++;
+  }
+
+  std::string nextString()
+  {
+    unsigned length = next();
+    unsigned words = (length + sizeof(unsigned) - 1) / sizeof(unsigned);
+    if (unsigned(_end - _pos) < words) {
+      USER_ERROR("Axiom snapshot " + _fileName + " is truncated");
+    }
+    std::string res(reinterpret_cast<const char*>(_pos), length);
+    _pos += words;
+    return res;
+  }
+
+  TermList nextSort(const Stack<unsigned>& typeCons)
+  {
+    unsigned word = next();
+    if (word & 1 || (word >> 1) >= typeCons.size()) {
+      USER_ERROR("Axiom snapshot " + _fileName + " is corrupted");
+    }
+    unsigned typeCon = typeCons[word >> 1];
+    unsigned arity = env.signature->getTypeCon(typeCon)->arity();
+    Recycled<Stack<TermList>> args;
+    for (unsigned i = 0; i < arity; i++) {
+      args->push(nextSort(typeCons));
+    }
+    return TermList(AtomicSort::create(typeCon, arity, args->begin()));
+  }
+
+  TermList nextTerm(const Stack<unsigned>& functions)
+  {
+    unsigned word = next();
+    if (word & 1) {
+      return TermList(word >> 1, false);
+    }
+    if ((word >> 1) >= functions.size()) {
+      USER_ERROR("Axiom snapshot " + _fileName + " is corrupted");
+    }
+    unsigned functor = functions[word >> 1];
+    unsigned arity = env.signature->getFunction(functor)->arity();
+    Recycled<Stack<TermList>> args;
+    for (unsigned i = 0; i < arity; i++) {
+      args->push(nextTerm(functions));
+    }
+    return TermList(Term::create(functor, arity, args->begin()));
+  }
+
+  bool atEnd() const { return _pos == _end; }
+
+private:
+  const std::string& _fileName;
+  const unsigned* _pos;
+  const unsigned* _end;
+};
+
+void AxiomSnapshot::load(const std::string& fileName, UnitList::FIFO& units)
+{
+  int fd = open(fileName.c_str(), O_RDONLY);
+  struct stat st;
+  if (fd == -1 || fstat(fd, &st) == -1) {
+    USER_ERROR("Cannot open axiom snapshot " + fileName);
+  }
+  size_t size = st.st_size;
+  void* mapped = size ? mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0) : MAP_FAILED;
+  close(fd);
+  if (mapped == MAP_FAILED || size % sizeof(unsigned)) {
+    USER_ERROR("Cannot read axiom snapshot " + fileName);
+  }
+  const unsigned* begin = static_cast<const unsigned*>(mapped);
+  SnapshotReader reader(fileName, begin, begin + size / sizeof(unsigned));
+
+  if (reader.next() != SNAPSHOT_MAGIC || reader.next() != SNAPSHOT_VERSION) {
+    USER_ERROR(fileName + " is not an axiom snapshot of this version of Vampire");
+  }
+
+  Stack<unsigned> typeCons;
+  unsigned typeConCount = reader.next();
+  for (unsigned i = 0; i < typeConCount; i++) {
+    std::string name = reader.nextString();
+    unsigned arity = reader.next();
+    bool added;
+    unsigned typeCon = env.signature->addTypeCon(name, arity, added);
+    if (added) {
+      env.signature->getTypeCon(typeCon)->setType(OperatorType::getTypeConType(arity));
+    }
+    typeCons.push(typeCon);
+  }
+  unsigned clauseCount = reader.next();
+
+  Stack<unsigned> symbols[2];
+  for (unsigned kind : { FUNCTION, PREDICATE }) {
+    unsigned count = reader.next();
+    for (unsigned i = 0; i < count; i++) {
+      std::string name = reader.nextString();
+      unsigned arity = reader.next();
+      unsigned flags = reader.next();
+      Recycled<Stack<TermList>> sorts;
+      for (unsigned j = 0; j < arity; j++) {
+        sorts->push(reader.nextSort(typeCons));
+      }
+      bool added;
+      unsigned symbol;
+      OperatorType* type;
+      if (kind == FUNCTION) {
+        TermList result = reader.nextSort(typeCons);
+        symbol = env.signature->addFunction(name, arity, added);
+        type = OperatorType::getFunctionType(arity, sorts->begin(), result);
+      } else {
+        symbol = env.signature->addPredicate(name, arity, added);
+        type = OperatorType::getPredicateType(arity, sorts->begin());
+      }
+      Signature::Symbol* sym = getSymbol(kind, symbol);
+      if (added) {
+        sym->setType(type);
+        if (flags & INTRODUCED) {
+          sym->markIntroduced();
+        }
+        if (flags & SKOLEM) {
+          sym->markSkolem();
+        }
+        if (flags & SKIP) {
+          sym->markSkip();
+        }
+      } else if ((kind == FUNCTION ? sym->fnType() : sym->predType()) != type) {
+        USER_ERROR("Symbol " + name + " of axiom snapshot " + fileName + " has a different type in the problem");
+      }
+      symbols[kind - FUNCTION].push(symbol);
+    }
+  }
+  const Stack<unsigned>& functions = symbols[0];
+  const Stack<unsigned>& predicates = symbols[1];
+
+  RStack<Literal*> lits;
+  Recycled<Stack<TermList>> args;
+  for (unsigned i = 0; i < clauseCount; i++) {
+    auto inputType = static_cast<UnitInputType>(reader.next());
+    unsigned length = reader.next();
+    lits->reset();
+    for (unsigned j = 0; j < length; j++) {
+      unsigned header = reader.next();
+      bool polarity = header & 2;
+      if (header & 1) {
+        TermList sort = reader.nextSort(typeCons);
+        TermList lhs = reader.nextTerm(functions);
+        TermList rhs = reader.nextTerm(functions);
+        lits->push(Literal::createEquality(polarity, lhs, rhs, sort));
+        continue;
+      }
+      if ((header >> 2) >= predicates.size()) {
+        USER_ERROR("Axiom snapshot " + fileName + " is corrupted");
+      }
+      unsigned pred = predicates[header >> 2];
+      unsigned arity = env.signature->getPredicate(pred)->arity();
+      args->reset();
+      for (unsigned k = 0; k < arity; k++) {
+        args->push(reader.nextTerm(functions));
+      }
+      lits->push(Literal::create(pred, arity, polarity, args->begin()));
+    }
+    units.pushBack(Clause::fromStack(*lits, FromInput(inputType)));
+  }
+  if (!reader.atEnd()) {
+    USER_ERROR("Axiom snapshot " + fileName + " is corrupted");
+  }
+
+  munmap(mapped, size);
+}
+
+}
@@ -0,0 +1,72 @@
+/*
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ */
+/**
+ * @file AxiomSnapshot.hpp
+ * Defines class AxiomSnapshot for saving clausified axioms to a file and loading them back.
+ */
+
+#ifndef __AxiomSnapshot__
+#define __AxiomSnapshot__
+
+#include <string>
+
+#include "Forwards.hpp"
+
+#include "Lib/DHMap.hpp"
+#include "Lib/List.hpp"
+#include "Lib/Stack.hpp"
+
+namespace Shell {
+
+using namespace Lib;
+using namespace Kernel;
+
+/**
+ * A binary file with clauses and the signature symbols they use.
+ *
+ * When many conjectures are proved from the same large set of axioms, the axioms
+ * can be parsed and clausified once, saved to a snapshot and in the later runs loaded
+ * from it, which is much faster than parsing and clausifying them again.
+ *
+ * The file is read through a memory mapping. Terms are shared by their addresses,
+ * so they cannot be mapped directly, and loading rebuilds them in the term bank.
+ * Symbols are matched to those already in the signature by their names and arities.
+ *
+ * Only monomorphic clauses without interpreted symbols (other than equality)
+ * can be saved.
+ */
+class AxiomSnapshot
+{
+public:
+  /** Save the clauses of @b clauses to @b fileName */
+  static void save(const std::string& fileName, ClauseIterator clauses);
+  /** Load the clauses saved in @b fileName and add them at the end of @b units */
+  static void load(const std::string& fileName, UnitList::FIFO& units);
+
+private:
+  enum SymbolKind { TYPE_CON = 0, FUNCTION = 1, PREDICATE = 2 };
+
+  AxiomSnapshot() {}
+
+  unsigned localSymbol(SymbolKind kind, unsigned symbol);
+  void writeTerm(TermList t);
+  void writeSort(TermList sort);
+  void writeLiteral(Literal* lit);
+
+  /** symbols of the signature numbered in the order of their first occurrence */
+  Stack<unsigned> _symbols[3];
+  DHMap<unsigned, unsigned> _localSymbols[3];
+  /** the encoded clauses */
+  Stack<unsigned> _words;
+};
+
+}
+
+#endif // __AxiomSnapshot__
@@ -117,7 +117,7 @@ struct FunctionDefinition::Def
   ~Def()
   {
     if(argOccurs) {
-      DEALLOC_KNOWN(argOccurs, lhs->arity()*sizeof(bool), "FunctionDefinition::Def::argOccurs");
+      DEALLOC_KNOWN(argOccurs, lhs->arity()*sizeof(bool), "Shell::FunctionDefinition::Def");
     }
   }
 }; // class FunctionDefintion::Def
@@ -486,7 +486,7 @@ void FunctionDefinition::assignArgOccursData(Def* updDef)
   }
 
   updDef->argOccurs=reinterpret_cast<bool*>(ALLOC_KNOWN(updDef->lhs->arity()*sizeof(bool),
-	    "FunctionDefinition::Def::argOccurs"));
+	    "Shell::FunctionDefinition::Def"));
   std::memset(updDef->argOccurs, 0, updDef->lhs->arity() * sizeof(bool));
 
   static DHMap<unsigned, unsigned, IdentityHash, DefaultHash> var2argIndex;
@@ -98,6 +98,13 @@ void Options::init()
     _memoryLimit.description="Attempt to limit memory use (in MB). Limits less than 20MB are ignored to allow Vampire to start. Known not to work on MacOS for mysterious reasons: https://forums.developer.apple.com/forums/thread/702803";
     _lookup.insert(&_memoryLimit);
 
+    _memoryCompaction = ChoiceOptionValue<MemoryCompaction>("memory_compaction","mco",MemoryCompaction::OFF,{"off","order","release"});
+    _memoryCompaction.description=
+      "Every now and then during saturation, defragment the memory of deleted clauses and terms. "
+      "With 'order', free memory is reused lowest address first, improving locality and letting blocks empty out. "
+      "With 'release', empty blocks are in addition given back to the system, to stay further from the memory limit.";
+    _lookup.insert(&_memoryCompaction);
+
 #if VAMPIRE_PERF_EXISTS
   _instructionLimit = UnsignedOptionValue("instruction_limit","i",0);
   _instructionLimit.description="Limit the number (in millions) of executed instructions (excluding the kernel ones).";
@@ -215,6 +222,27 @@ void Options::init()
     _lookup.insert(&_randomizSeedForPortfolioWorkers);
     _randomizSeedForPortfolioWorkers.onlyUsefulWith(UsingPortfolioTechnology());
 
+    _portfolioPreprocessingCache = BoolOptionValue("portfolio_preprocessing_cache","ppc",false);
+    _portfolioPreprocessingCache.description = "In portfolio mode, preprocess the problem only once for all the strategies that agree on the preprocessing-relevant options "
+      "and let the corresponding workers start directly from the preprocessed snapshot. (Linux only.)";
+    _lookup.insert(&_portfolioPreprocessingCache);
+    _portfolioPreprocessingCache.onlyUsefulWith(UsingPortfolioTechnology());
+
+    _portfolioStallLimit = UnsignedOptionValue("portfolio_stall_limit","pstl",0);
+    _portfolioStallLimit.description = "In portfolio mode, let the workers report on their progress and preempt a worker "
+      "which has not completed an activation for this many seconds (0 means never). "
+      "When the schedule gets repeated with doubled limits, the preempted strategies are left out "
+      "and the ones which were still making progress when running out of time go first.";
+    _lookup.insert(&_portfolioStallLimit);
+    _portfolioStallLimit.onlyUsefulWith(UsingPortfolioTechnology());
+
+    _portfolioLemmaExchange = BoolOptionValue("portfolio_lemma_exchange","ple",false);
+    _portfolioLemmaExchange.description = "In portfolio mode, let the strategies running in parallel share the light unit clauses "
+      "over the input signature they derive (and which do not depend on AVATAR splits). "
+      "Not available for higher-order problems and with question answering.";
+    _lookup.insert(&_portfolioLemmaExchange);
+    _portfolioLemmaExchange.onlyUsefulWith(UsingPortfolioTechnology());
+
     _decode = DecodeOptionValue("decode","",this);
     _decode.description="Decodes an encoded strategy. Can be used to replay a strategy. To make Vampire output an encoded version of the strategy use the encode option.";
     _lookup.insert(&_decode);
@@ -397,6 +425,19 @@ void Options::init()
     _timeStatisticsFocus.onlyUsefulWith(_timeStatistics.is(equal(true)));
 #endif // VTIME_PROFILING
 
+    _memoryStatistics = UnsignedOptionValue("memory_statistics","mstat",0);
+    _memoryStatistics.description="If not 0, show the occupancy of the allocators and the memory in use by each kind of object, "
+      "at the end and during saturation every this many activations "
+      "(the memory by kind of object only in builds with ALLOCATION_STATISTICS)";
+    _lookup.insert(&_memoryStatistics);
+    _memoryStatistics.tag(OptionTag::OUTPUT);
+
+    _indexStatistics = UnsignedOptionValue("index_statistics","istat",0);
+    _indexStatistics.description="If not 0, show for every index the clauses in it, its nodes, the queries, their results and the time spent, "
+      "at the end and during saturation every this many activations";
+    _lookup.insert(&_indexStatistics);
+    _indexStatistics.tag(OptionTag::OUTPUT);
+
 //*********************** Input  ***********************
 
     _include = StringOptionValue("include","","");
@@ -404,6 +445,14 @@ void Options::init()
     _lookup.insert(&_include);
     _include.tag(OptionTag::INPUT);
 
+    _axiomSnapshot = StringOptionValue("axiom_snapshot","","");
+    _axiomSnapshot.description=
+      "File with a snapshot of clausified axioms, for proving many conjectures from the same large axiom set. "
+      "In the clausify mode, the clauses not derived from the conjecture are written to it. "
+      "In the other modes, its clauses are added to the input problem, which then only needs to contain the conjecture.";
+    _lookup.insert(&_axiomSnapshot);
+    _axiomSnapshot.tag(OptionTag::INPUT);
+
     _inputFile= InputFileOptionValue("input_file","","",this);
     _inputFile.description="Problem file to be solved (if not specified, standard input is used)";
     _lookup.insert(&_inputFile);
@@ -520,6 +569,16 @@ void Options::init()
     _codeTreeSubsumption.setExperimental();
     _lookup.insert(&_codeTreeSubsumption);
 
+    _featureVectorSubsumption = ChoiceOptionValue<FeatureVectorSubsumption>("feature_vector_subsumption", "fvs",
+      FeatureVectorSubsumption::OFF, {"off", "literals", "symbols"});
+    _featureVectorSubsumption.description =
+      "Use a feature vector index for forward subsumption and subsumption resolution instead of code_tree_subsumption. "
+      "The trie of the index branches on the numbers of positive and negative literals and the size of the largest literal (literals), "
+      "or on these and on whether the clause has a predicate from the first few buckets of predicate symbols (symbols).";
+    _featureVectorSubsumption.tag(OptionTag::INFERENCES);
+    _featureVectorSubsumption.setExperimental();
+    _lookup.insert(&_featureVectorSubsumption);
+
     _generalSplitting = BoolOptionValue("general_splitting","gsp",false);
     _generalSplitting.description=
     "Splits clauses in order to reduce number of different variables in each clause. "
@@ -804,6 +863,31 @@ void Options::init()
     // make the next hard - RSTC will make FMB crash (as RSTC correctly does not trigger hadIncompleteTransformation; still it probably does not make sense to use ep with fmb)
     _saturationAlgorithm.addHardConstraint(If(equal(SaturationAlgorithm::FINITE_MODEL_BUILDING)).then(_equalityProxy.is(notEqual(EqualityProxy::RSTC))));
 
+    _batchedForwardSimplification = BoolOptionValue("batched_forward_simplification","bfsi",false);
+    _batchedForwardSimplification.description = "With discount, forward simplify the new clauses in batches: "
+      "run each forward simplification engine over the whole batch before moving on to the next one. "
+      "(The simplifying clauses do not change while new clauses are being processed, so this only affects the order "
+      "in which the replacements of the simplified clauses get processed.)";
+    _lookup.insert(&_batchedForwardSimplification);
+    _batchedForwardSimplification.tag(OptionTag::SATURATION);
+    _batchedForwardSimplification.onlyUsefulWith(_saturationAlgorithm.is(equal(SaturationAlgorithm::DISCOUNT)));
+
+    _compactPassive = BoolOptionValue("compact_passive","cpa",false);
+    _compactPassive.description = "With discount, keep the passive clauses in a compact form, which only stores their literals, "
+      "weights and inferences, and construct them again when they are selected. This saves memory on large passive sets. "
+      "(Clauses with splitting assertions stay as they are. The compact clauses are not seen by the variant filter.)";
+    _lookup.insert(&_compactPassive);
+    _compactPassive.tag(OptionTag::SATURATION);
+    _compactPassive.onlyUsefulWith(_saturationAlgorithm.is(equal(SaturationAlgorithm::DISCOUNT)));
+
+    _passiveSpillMemory = UnsignedOptionValue("passive_spill_memory","psm",0);
+    _passiveSpillMemory.description = "With compact_passive, when the compact passive clauses take more than this many MB, write those "
+      "that are furthest from being selected to a temporary file, and read them back in parts when their turn comes. "
+      "The clauses are selected in the same order as without the spilling. (0 means never spill.)";
+    _lookup.insert(&_passiveSpillMemory);
+    _passiveSpillMemory.tag(OptionTag::SATURATION);
+    _passiveSpillMemory.onlyUsefulWith(_compactPassive.is(equal(true)));
+
     auto ProperSaturationAlgorithm = [this] {
       return Or(_saturationAlgorithm.is(equal(SaturationAlgorithm::LRS)),
                 _saturationAlgorithm.is(equal(SaturationAlgorithm::OTTER)),
@@ -1795,6 +1879,13 @@ void Options::init()
     _forwardLiteralRewriting.addProblemConstraint(mayHaveNonUnits());
     _forwardLiteralRewriting.onlyUsefulWith(ProperSaturationAlgorithm());
 
+    _variantFilter = BoolOptionValue("variant_filter","vf",false);
+    _variantFilter.description="Drop the new clauses that are variants of clauses (with the same splitting assertions) "
+      "in the unprocessed, passive or active container, before simplifying them.";
+    _lookup.insert(&_variantFilter);
+    _variantFilter.onlyUsefulWith(ProperSaturationAlgorithm());
+    _variantFilter.tag(OptionTag::INFERENCES);
+
     _forwardSubsumption = BoolOptionValue("forward_subsumption","fs",true);
     _forwardSubsumption.description="Perform forward subsumption deletion.";
     _lookup.insert(&_forwardSubsumption);
@@ -2401,6 +2492,13 @@ void Options::init()
     _lookup.insert(&_introducedSymbolPrecedence);
     _introducedSymbolPrecedence.tag(OptionTag::SATURATION);
 
+    _orderingCache = UnsignedOptionValue("ordering_cache","oc",0);
+    _orderingCache.description = "Keep the results of comparing pairs of shared terms by the term ordering in a cache with this many entries "
+      "(rounded up to a power of two), so that comparing the same pair again takes a single lookup. (0 means no cache.)";
+    _lookup.insert(&_orderingCache);
+    _orderingCache.onlyUsefulWith(ProperSaturationAlgorithm());
+    _orderingCache.tag(OptionTag::SATURATION);
+
     _kboWeightGenerationScheme = ChoiceOptionValue<KboWeightGenerationScheme>("kbo_weight_scheme","kws",KboWeightGenerationScheme::CONST,
                                           {"const","random","arity","inv_arity","arity_squared","inv_arity_squared",
                                           "precedence","inv_precedence","frequency","inv_frequency"});
@@ -3487,6 +3585,7 @@ std::string Options::generateEncodedOptions() const
     forbidden.insert(&_intent);
     forbidden.insert(&_testId); // is this old version of decode?
     forbidden.insert(&_include);
+    forbidden.insert(&_axiomSnapshot);
     forbidden.insert(&_printProofToFile);
     forbidden.insert(&_problemName);
     forbidden.insert(&_inputFile);
@@ -3524,6 +3623,112 @@ std::string Options::generateEncodedOptions() const
   return res.str();
 }
 
+/**
+ * Return a string summarising all the option values which can influence preprocessing.
+ *
+ * Two Options objects with the same key lead Preprocess to the same result
+ * (modulo the random seed, see randomizedPreprocessing()), which is what
+ * PortfolioMode uses to share a preprocessed problem between its workers.
+ *
+ * The key is built from an explicit list of the options read while preprocessing
+ * (by Preprocess and the transformations it calls), together with those which
+ * influence what is cached on the clauses it creates (e.g. their weights).
+ * An option read by preprocessing must be added here, otherwise workers
+ * differing only in it would share a preprocessed problem.
+ */
+std::string Options::preprocessingKey() const
+{
+  static Set<const AbstractOptionValue*> relevant;
+  if (relevant.size()==0) {
+    // the preprocessing steps themselves
+    relevant.insert(&_addCombAxioms);
+    relevant.insert(&_addProxyAxioms);
+    relevant.insert(&_alasca);
+    relevant.insert(&_alascaIntegerConversion);
+    relevant.insert(&_blockedClauseElimination);
+    relevant.insert(&_cases);
+    relevant.insert(&_casesSimp);
+    relevant.insert(&_choiceAxiom);
+    relevant.insert(&_choiceReasoning);
+    relevant.insert(&_clausificationOnTheFly);
+    relevant.insert(&_distinctGroupExpansionLimit);
+    relevant.insert(&_equalityProxy);
+    relevant.insert(&_equalityResolutionWithDeletion);
+    relevant.insert(&_equalityToEquivalence);
+    relevant.insert(&_FOOLParamodulation);
+    relevant.insert(&_functionDefinitionElimination);
+    relevant.insert(&_functionExtensionality);
+    relevant.insert(&_generalSplitting);
+    relevant.insert(&_guessTheGoal);
+    relevant.insert(&_guessTheGoalLimit);
+    relevant.insert(&_ignoreConjectureInPreprocessing);
+    relevant.insert(&_inequalitySplitting);
+    relevant.insert(&_inlineLet);
+    relevant.insert(&_naming);
+    relevant.insert(&_newCNF);
+    relevant.insert(&_normalize);
+    relevant.insert(&_questionAnswering);
+    relevant.insert(&_questionAnsweringGroundOnly);
+    relevant.insert(&_randomPolarities);
+    relevant.insert(&_saturationAlgorithm);
+    relevant.insert(&_shuffleInput);
+    relevant.insert(&_sineDepth);
+    relevant.insert(&_sineGeneralityThreshold);
+    relevant.insert(&_sineSelection);
+    relevant.insert(&_sineTolerance);
+    relevant.insert(&_sineToAge);
+    relevant.insert(&_sineToAgeGeneralityThreshold);
+    relevant.insert(&_sineToAgeTolerance);
+    relevant.insert(&_sineToPredLevels);
+    relevant.insert(&_symbolPrecedence);
+    relevant.insert(&_termAlgebraCyclicityCheck);
+    relevant.insert(&_termAlgebraExhaustivenessAxiom);
+    relevant.insert(&_theoryAxioms);
+    relevant.insert(&_theoryFlattening);
+    relevant.insert(&_tweeGoalTransformation);
+    relevant.insert(&_unusedPredicateDefinitionRemoval);
+    relevant.insert(&_useMonoEqualityProxy);
+    relevant.insert(&_useSineLevelSplitQueues);
+    // read when creating the symbols and clauses of the preprocessed problem
+    relevant.insert(&_arityCheck);
+    relevant.insert(&_protectedPrefix);
+    relevant.insert(&_functionDefinitionRewriting);
+    relevant.insert(&_superpositionFromVariables);
+    // cached on the clauses (weights, inference data)
+    relevant.insert(&_increasedNumeralWeight);
+    relevant.insert(&_restrictNWCtoGC);
+    relevant.insert(&_nonliteralsInClauseWeight);
+    relevant.insert(&_theorySplitQueueExpectedRatioDenom);
+    relevant.insert(&_randomTraversals);
+    // what the preprocessing prints
+    relevant.insert(&_printClausifierPremises);
+    relevant.insert(&_proofExtra);
+    relevant.insert(&_showAll);
+    relevant.insert(&_showFOOL);
+    relevant.insert(&_showNonconstantSkolemFunctionTrace);
+    relevant.insert(&_showPreprocessing);
+    relevant.insert(&_showSkolemisations);
+    relevant.insert(&_showTheoryAxioms);
+  }
+
+  std::ostringstream res;
+  bool first = true;
+  VirtualIterator<AbstractOptionValue*> options = _lookup.values();
+  while(options.hasNext()){
+    AbstractOptionValue* option = options.next();
+    if (option->isDefault()) {
+      continue;
+    }
+    if (!relevant.contains(option) &&
+        (option != &_randomSeed || !randomizedPreprocessing())) {
+      continue;
+    }
+    if(!first){ res<<":";}else{first=false;}
+    res << option->longName << "=" << option->getStringOfActual();
+  }
+  return res.str();
+}
+
 /**
  * Some options have auto-values,
  * which should be resolved away BEFORE preprocessing.
@@ -95,6 +95,8 @@ public:
     void readFromEncodedOptions (std::string testId);
     void readOptionsString (std::string testId,bool assign=true);
     std::string generateEncodedOptions() const;
+    // options which may influence the outcome of preprocessing, cf. PortfolioMode
+    std::string preprocessingKey() const;
 
     // compile away auto-values; called BEFORE preprocessing
     void resolveAwayAutoValues0();
@@ -480,6 +482,12 @@ public:
     ON = 2
   };
 
+  enum class MemoryCompaction : unsigned int {
+    OFF = 0,
+    ORDER = 1,
+    RELEASE = 2
+  };
+
   enum class QuestionAnsweringMode : unsigned int {
     AUTO = 0,
     PLAIN = 1,
@@ -519,6 +527,12 @@ public:
     UNIT_ONLY = 2
   };
 
+  enum class FeatureVectorSubsumption : unsigned int {
+    OFF = 0,
+    LITERALS = 1,
+    SYMBOLS = 2
+  };
+
   enum class URResolution : unsigned int {
     EC_ONLY = 0,
     OFF = 1,
@@ -2014,6 +2028,7 @@ public:
   void setNaming(int n){ _naming.actualValue = n;} //TODO: ensure global constraints
   std::string include() const { return _include.actualValue; }
   void setInclude(std::string val) { _include.actualValue = val; }
+  std::string axiomSnapshot() const { return _axiomSnapshot.actualValue; }
   std::string inputFile() const { return _inputFile.actualValue; }
   void resetInputFile() { _inputFile.actualValue = ""; }
   int activationLimit() const { return _activationLimit.actualValue; }
@@ -2096,6 +2111,9 @@ public:
   bool forwardSubsumptionResolution() const { return _forwardSubsumptionResolution.actualValue; }
   //void setForwardSubsumptionResolution(bool newVal) { _forwardSubsumptionResolution = newVal; }
   bool forwardSubsumptionDemodulation() const { return _forwardSubsumptionDemodulation.actualValue; }
+  bool batchedForwardSimplification() const { return _batchedForwardSimplification.actualValue; }
+  bool compactPassive() const { return _compactPassive.actualValue; }
+  unsigned passiveSpillMemory() const { return _passiveSpillMemory.actualValue; }
   unsigned forwardSubsumptionDemodulationMaxMatches() const { return _forwardSubsumptionDemodulationMaxMatches.actualValue; }
   Demodulation forwardDemodulation() const { return _forwardDemodulation.actualValue; }
   bool binaryResolution() const { return _binaryResolution.actualValue; }
@@ -2122,6 +2140,7 @@ public:
   bool backwardSubsumptionDemodulation() const { return _backwardSubsumptionDemodulation.actualValue; }
   unsigned backwardSubsumptionDemodulationMaxMatches() const { return _backwardSubsumptionDemodulationMaxMatches.actualValue; }
   bool forwardSubsumption() const { return _forwardSubsumption.actualValue; }
+  bool variantFilter() const { return _variantFilter.actualValue; }
   bool forwardLiteralRewriting() const { return _forwardLiteralRewriting.actualValue; }
   int lrsFirstTimeCheck() const { return _lrsFirstTimeCheck.actualValue; }
   int lrsWeightLimitOnly() const { return _lrsWeightLimitOnly.actualValue; }
@@ -2134,6 +2153,7 @@ public:
   SymbolPrecedence symbolPrecedence() const { return _symbolPrecedence.actualValue; }
   SymbolPrecedenceBoost symbolPrecedenceBoost() const { return _symbolPrecedenceBoost.actualValue; }
   IntroducedSymbolPrecedence introducedSymbolPrecedence() const { return _introducedSymbolPrecedence.actualValue; }
+  unsigned orderingCache() const { return _orderingCache.actualValue; }
   KboWeightGenerationScheme kboWeightGenerationScheme() const { return _kboWeightGenerationScheme.actualValue; }
   bool kboMaxZero() const { return _kboMaxZero.actualValue; }
   const KboAdmissibilityCheck kboAdmissabilityCheck() const { return _kboAdmissabilityCheck.actualValue; }
@@ -2146,6 +2166,7 @@ public:
   int timeLimitInDeciseconds() const { return _timeLimitInDeciseconds.actualValue; }
   size_t memoryLimit() const { return _memoryLimit.actualValue; }
   void setMemoryLimitOptionValue(size_t newVal) { _memoryLimit.actualValue = newVal; }
+  MemoryCompaction memoryCompaction() const { return _memoryCompaction.actualValue; }
 #if VAMPIRE_PERF_EXISTS
   unsigned instructionLimit() const { return _instructionLimit.actualValue; }
   void setInstructionLimit(unsigned newVal) { _instructionLimit.actualValue = newVal; }
@@ -2202,6 +2223,11 @@ public:
   bool randomTraversals() const { return _randomTraversals.actualValue; }
   bool randomizeSeedForPortfolioWorkers() const { return _randomizSeedForPortfolioWorkers.actualValue; }
   void setRandomizeSeedForPortfolioWorkers(bool val) { _randomizSeedForPortfolioWorkers.actualValue = val; }
+  bool portfolioPreprocessingCache() const { return _portfolioPreprocessingCache.actualValue; }
+  unsigned portfolioStallLimit() const { return _portfolioStallLimit.actualValue; }
+  bool portfolioLemmaExchange() const { return _portfolioLemmaExchange.actualValue; }
+  /** true if the random seed influences the outcome of preprocessing */
+  bool randomizedPreprocessing() const { return shuffleInput() || randomPolarities() || randomTraversals(); }
 
   bool ignoreConjectureInPreprocessing() const {return _ignoreConjectureInPreprocessing.actualValue;}
 
@@ -2209,6 +2235,7 @@ public:
   unsigned functionDefinitionIntroduction() const { return _functionDefinitionIntroduction.actualValue; }
   TweeGoalTransformation tweeGoalTransformation() const { return _tweeGoalTransformation.actualValue; }
   bool codeTreeSubsumption() const { return _codeTreeSubsumption.actualValue; }
+  FeatureVectorSubsumption featureVectorSubsumption() const { return _featureVectorSubsumption.actualValue; }
   bool outputAxiomNames() const { return _outputAxiomNames.actualValue; }
   void setOutputAxiomNames(bool newVal) { _outputAxiomNames.actualValue = newVal; }
   QuestionAnsweringMode questionAnswering() const { return _questionAnswering.actualValue; }
@@ -2236,6 +2263,8 @@ public:
   bool timeStatistics() const { return _timeStatistics.actualValue; }
   std::string const& timeStatisticsFocus() const { return _timeStatisticsFocus.actualValue; }
 #endif // VTIME_PROFILING
+  unsigned memoryStatistics() const { return _memoryStatistics.actualValue; }
+  unsigned indexStatistics() const { return _indexStatistics.actualValue; }
   bool splitting() const { return _splitting.actualValue; }
   void setSplitting(bool value){ _splitting.actualValue=value; }
   bool nonliteralsInClauseWeight() const { return _nonliteralsInClauseWeight.actualValue; }
@@ -2503,13 +2532,18 @@ private:
   ChoiceOptionValue<Demodulation> _forwardDemodulation;
   BoolOptionValue _forwardLiteralRewriting;
   BoolOptionValue _forwardSubsumption;
+  BoolOptionValue _variantFilter;
   BoolOptionValue _forwardSubsumptionResolution;
   BoolOptionValue _forwardSubsumptionDemodulation;
+  BoolOptionValue _batchedForwardSimplification;
+  BoolOptionValue _compactPassive;
+  UnsignedOptionValue _passiveSpillMemory;
   UnsignedOptionValue _forwardSubsumptionDemodulationMaxMatches;
   ChoiceOptionValue<FunctionDefinitionElimination> _functionDefinitionElimination;
   UnsignedOptionValue _functionDefinitionIntroduction;
   ChoiceOptionValue<TweeGoalTransformation> _tweeGoalTransformation;
   BoolOptionValue _codeTreeSubsumption;
+  ChoiceOptionValue<FeatureVectorSubsumption> _featureVectorSubsumption;
 
   BoolOptionValue _generalSplitting;
   BoolOptionValue _globalSubsumption;
@@ -2530,6 +2564,7 @@ private:
   /** if true, then calling set() on non-existing options will not result in a user error */
   ChoiceOptionValue<IgnoreMissing> _ignoreMissing;
   StringOptionValue _include;
+  StringOptionValue _axiomSnapshot;
   /** if this option is true, Vampire will add the numeral weight of a clause
    * to its weight. The weight is defined as the sum of binary sizes of all
    * integers occurring in this clause. This option has not been tested and
@@ -2582,6 +2617,7 @@ private:
 #endif
 
   UnsignedOptionValue _memoryLimit; // should be size_t, making an assumption
+  ChoiceOptionValue<MemoryCompaction> _memoryCompaction;
 
   BoolOptionValue _interactive;
 
@@ -2592,6 +2628,9 @@ private:
   UnsignedOptionValue _multicore;
   FloatOptionValue _slowness;
   BoolOptionValue _randomizSeedForPortfolioWorkers;
+  BoolOptionValue _portfolioPreprocessingCache;
+  UnsignedOptionValue _portfolioStallLimit;
+  BoolOptionValue _portfolioLemmaExchange;
 
   IntOptionValue _naming;
   BoolOptionValue _nonliteralsInClauseWeight;
@@ -2703,6 +2742,7 @@ private:
   ChoiceOptionValue<SymbolPrecedenceBoost> _symbolPrecedenceBoost;
   ChoiceOptionValue<IntroducedSymbolPrecedence> _introducedSymbolPrecedence;
   ChoiceOptionValue<EvaluationMode> _evaluationMode;
+  UnsignedOptionValue _orderingCache;
   ChoiceOptionValue<KboWeightGenerationScheme> _kboWeightGenerationScheme;
   BoolOptionValue _kboMaxZero;
   ChoiceOptionValue<KboAdmissibilityCheck> _kboAdmissabilityCheck;
@@ -2726,6 +2766,8 @@ private:
   BoolOptionValue _timeStatistics;
   StringOptionValue _timeStatisticsFocus;
 #endif // VTIME_PROFILING
+  UnsignedOptionValue _memoryStatistics;
+  UnsignedOptionValue _indexStatistics;
 
   ChoiceOptionValue<URResolution> _unitResultingResolution;
   BoolOptionValue _unusedPredicateDefinitionRemoval;
@@ -268,6 +268,76 @@ void SineBase::initGeneralityFunction(UnitList* units)
   }
 }
 
+ScopedPtr<SineTriggerIndex> SineTriggerIndex::s_cached;
+
+SineTriggerIndex& SineTriggerIndex::forUnits(UnitList* units)
+{
+  if (!s_cached || !s_cached->indexes(units)) {
+    s_cached = new SineTriggerIndex(units);
+  }
+  return *s_cached;
+}
+
+bool SineTriggerIndex::indexes(UnitList* units) const
+{
+  unsigned i = 0;
+  UnitList::Iterator uit(units);
+  while (uit.hasNext()) {
+    // the numbers tell apart different units allocated at the same address
+    Unit* u = uit.next();
+    if (i == _units.size() || _units[i] != u || _unitNumbers[i] != u->number()) {
+      return false;
+    }
+    i++;
+  }
+  return i == _units.size();
+}
+
+SineTriggerIndex::SineTriggerIndex(UnitList* units)
+{
+  TIME_TRACE("sine trigger index");
+
+  SymId symIdBound=_symExtr.getSymIdBound();
+  _gen.init(symIdBound,0);
+
+  _unitSymbolsStart.push(0);
+  UnitList::Iterator uit(units);
+  while (uit.hasNext()) {
+    Unit* u=uit.next();
+    _units.push(u);
+    _unitNumbers.push(u->number());
+    SymIdIterator sit=_symExtr.extractSymIds(u);
+    while (sit.hasNext()) {
+      SymId sym=sit.next();
+      _unitSymbols.push(sym);
+      _gen[sym]++;
+    }
+    _unitSymbolsStart.push(_unitSymbols.size());
+  }
+
+  _occurrencesStart.init(symIdBound,0);
+  unsigned total=0;
+  for (SymId sym=0; sym<symIdBound; sym++) {
+    _occurrencesStart[sym]=total;
+    total+=_gen[sym];
+  }
+
+  // fill in the occurrences from the last unit to the first one
+  DArray<unsigned> filled;
+  filled.init(symIdBound,0);
+  _occurrences.init(total,Occurrence{0,0});
+  for (unsigned i=_units.size(); i-- > 0; ) {
+    unsigned leastGenerality=UINT_MAX;
+    for (unsigned j=0; j<symbolCount(i); j++) {
+      leastGenerality=min(leastGenerality,_gen[symbol(i,j)]);
+    }
+    for (unsigned j=0; j<symbolCount(i); j++) {
+      SymId sym=symbol(i,j);
+      _occurrences[_occurrencesStart[sym] + filled[sym]++]=Occurrence{i,leastGenerality};
+    }
+  }
+}
+
 SineSelector::SineSelector(const Options& opt)
 : _onIncluded(opt.sineSelection()==Options::SineSelection::INCLUDED),
   _genThreshold(opt.sineGeneralityThreshold()),
@@ -296,81 +366,27 @@ void SineSelector::init()
 }
 
 /**
- * Connect unit @b u with symbols it defines
+ * Is the D-relation between @b sym and a unit whose least general symbol
+ * has generality @b leastGenerality, i.e. is @b sym a trigger of the unit?
  */
-void SineSelector::updateDefRelation(Unit* u)
+bool SineSelector::triggers(const SineTriggerIndex& index, SymId sym, unsigned leastGenerality) const
 {
-  SymIdIterator sit=_symExtr.extractSymIds(u);
-
-  if (!sit.hasNext()) {
-    if(_justForSineLevels){
-      u->inference().setSineLevel(0);
-      //cout << "set level for a non-symboler " << u->toString() << " as " << "(0)" << endl;
-    }
-    _unitsWithoutSymbols.push(u);
-    return;
-  }
-
-  static Stack<SymId> equalGenerality;
-  equalGenerality.reset();
-
-  SymId leastGenSym=sit.next();
-  unsigned leastGenVal=_gen[leastGenSym];
+  unsigned val=index.generality(sym);
+  ASS_G(val,0);
 
-  //it a symbol fits under _genThreshold, add it immediately [into the relation]
-  if (leastGenVal<=_genThreshold) {
-    UnitList::push(u,_def[leastGenSym]);
+  //a symbol that fits under _genThreshold always triggers
+  if (val<=_genThreshold) {
+    return true;
   }
-
-  while (sit.hasNext()) {
-    SymId sym=sit.next();
-    unsigned val=_gen[sym];
-    ASS_G(val,0);
-
-    //it a symbol fits under _genThreshold, add it immediately [into the relation]
-    if (val<=_genThreshold) {
-      UnitList::push(u,_def[sym]);
-    }
-
-    if (val<leastGenVal) {
-      leastGenSym=sym;
-      leastGenVal=val;
-      equalGenerality.reset();
-    } else if (val==leastGenVal) {
-      equalGenerality.push(sym);
-    }
-  }
-
-
   if (_strict) {
-    //only if the least general symbol is over _genThreshold; otherwise it is already added
-    if (leastGenVal>_genThreshold) {
-      UnitList::push(u,_def[leastGenSym]);
-      while (equalGenerality.isNonEmpty()) {
-        UnitList::push(u,_def[equalGenerality.pop()]);
-      }
-    }
+    //only the least general symbols
+    return val==leastGenerality;
   }
-  else {
-    unsigned generalityLimit=static_cast<int>(leastGenVal*_tolerance);
-    if (_tolerance==-1.0f) {
-      generalityLimit = UINT_MAX;
-    }
-
-    //if the generalityLimit is under _genThreshold, all suitable symbols are already added
-    if (generalityLimit>_genThreshold) {
-      sit=_symExtr.extractSymIds(u);
-      while (sit.hasNext()) {
-	SymId sym=sit.next();
-	unsigned val=_gen[sym];
-	//only if the symbol is over _genThreshold; otherwise it is already added
-	if (val>_genThreshold && val<=generalityLimit) {
-	  UnitList::push(u,_def[sym]);
-	}
-      }
-    }
+  if (_tolerance==-1.0f) {
+    return true;
   }
-
+  unsigned generalityLimit=static_cast<int>(leastGenerality*_tolerance);
+  return val<=generalityLimit;
 }
 
 void SineSelector::perform(Problem& prb)
@@ -385,51 +401,62 @@ bool SineSelector::perform(UnitList*& units)
 {
   TIME_TRACE(TimeTrace::SINE_SELECTION);
 
-  initGeneralityFunction(units);
-
-  SymId symIdBound=_symExtr.getSymIdBound();
+  const SineTriggerIndex& index=SineTriggerIndex::forUnits(units);
+  unsigned unitCnt=index.unitCount();
 
-  Set<Unit*> selected;
+  DArray<bool> selected;
+  selected.init(unitCnt,false);
   Stack<Unit*> selectedStack; //on this stack there are Units in the order they were selected
-  Deque<Unit*> newlySelected;
-
-  //build the D-relation and select the non-axiom formulas
-  _def.init(symIdBound,0);
-  unsigned numberUnitsLeftOut = 0;
-  UnitList::Iterator uit2(units);
-  while (uit2.hasNext()) {
-    numberUnitsLeftOut++;
-    Unit* u=uit2.next();
+  Deque<unsigned> newlySelected; //positions of the units in the index
+  static const unsigned DEPTH_MARK=UINT_MAX;
+
+  /**
+   * Formulas that don't contain any symbols
+   *
+   * These formulas are always selected.
+   */
+  Stack<Unit*> unitsWithoutSymbols;
+
+  //select the non-axiom formulas
+  unsigned numberUnitsLeftOut = unitCnt;
+  for (unsigned i=0; i<unitCnt; i++) {
+    Unit* u=index.unit(i);
     bool performSelection= _onIncluded ? u->included() : ((u->inputType()==UnitInputType::AXIOM)
                             || (env.options->guessTheGoal() != Options::GoalGuess::OFF && u->inputType()==UnitInputType::ASSUMPTION));
-    if (performSelection) { // register the unit for later
-      updateDefRelation(u);
+    if (performSelection) { // left for the selection by the D-relation
+      if (index.symbolCount(i)==0) {
+        if(_justForSineLevels){
+          u->inference().setSineLevel(0);
+        }
+        unitsWithoutSymbols.push(u);
+      }
     }
     else { // goal units are immediately taken (well, non-axiom, to by more precise. Includes ASSUMPTION, which cl->isGoal() does not take into account)
-      selected.insert(u);
+      selected[i]=true;
       selectedStack.push(u);
-      newlySelected.push_back(u);
+      newlySelected.push_back(i);
 
       if(_justForSineLevels) {
         u->inference().setSineLevel(0);
-        //cout << "set level for " << u->toString() << " as " << "(0)" << endl;
       }
     }
   }
 
-  unsigned depth=0;
-  newlySelected.push_back(0);
+  //all the units triggered by a symbol are selected the first time the symbol is reached
+  DArray<bool> symbolDone;
+  symbolDone.init(index.symIdBound(),false);
 
-  // cout << "env.maxClausePriority starts as" << env.maxClausePriority << endl;
+  unsigned depth=0;
+  newlySelected.push_back(DEPTH_MARK);
 
   //select required axiom formulas
   while (newlySelected.isNonEmpty()) {
-    Unit* u=newlySelected.pop_front();
+    unsigned i=newlySelected.pop_front();
 
-    if (!u) {
+    if (i==DEPTH_MARK) {
       //next selected formulas will be one step further from the original formulas
       depth++;
-      
+
       if (_depthLimit && depth==_depthLimit) {
 	break;
       }
@@ -439,18 +466,16 @@ bool SineSelector::perform(UnitList*& units)
           env.maxSineLevel++;
         }
       }
-      // cout << "Time to inc" << endl;
 
       if (newlySelected.isNonEmpty()) {
 	//we must push another mark if we're not done yet
-	newlySelected.push_back(0);
+	newlySelected.push_back(DEPTH_MARK);
       }
       continue;
     }
 
-    SymIdIterator sit=_symExtr.extractSymIds(u);
-    while (sit.hasNext()) {
-      SymId sym=sit.next();
+    for (unsigned j=0; j<index.symbolCount(i); j++) {
+      SymId sym=index.symbol(i,j);
 
       if (env.predicateSineLevels) {
         bool pred;
@@ -458,29 +483,28 @@ bool SineSelector::perform(UnitList*& units)
         SineSymbolExtractor::decodeSymId(sym,pred,functor);
         if (pred && !env.predicateSineLevels->find(functor)) {
           env.predicateSineLevels->insert(functor,env.maxSineLevel);
-          // cout << "set level of predicate " << functor << " i.e. " << env.signature->predicateName(functor) << " to " << env.maxClausePriority << endl;
         }
       }
 
-      UnitList::Iterator defUnits(_def[sym]);
-      while (defUnits.hasNext()) {
-        Unit* du=defUnits.next();
-        if (selected.contains(du)) {
+      if (symbolDone[sym]) {
+        continue;
+      }
+      symbolDone[sym]=true;
+
+      for (unsigned k=0; k<index.occurrenceCount(sym); k++) {
+        const SineTriggerIndex::Occurrence& occ=index.occurrence(sym,k);
+        if (selected[occ.unit] || !triggers(index,sym,occ.leastGenerality)) {
           continue;
         }
-        selected.insert(du);
+        Unit* du=index.unit(occ.unit);
+        selected[occ.unit]=true;
         selectedStack.push(du);
-        newlySelected.push_back(du);
+        newlySelected.push_back(occ.unit);
 
         if(_justForSineLevels){
           du->inference().setSineLevel(env.maxSineLevel);
-          //cout << "set level for " << du->toString() << " in iteration as " << env.maxClausePriority << endl;
         }
       }
-      //all defining units for the symbol sym were selected,
-      //so we can remove them from the relation
-      UnitList::destroy(_def[sym]);
-      _def[sym]=0;
     }
   }
 
@@ -490,13 +514,13 @@ bool SineSelector::perform(UnitList*& units)
   }
 
   env.statistics->sineIterations=depth;
-  env.statistics->selectedBySine=_unitsWithoutSymbols.size() + selectedStack.size();
+  env.statistics->selectedBySine=unitsWithoutSymbols.size() + selectedStack.size();
 
   numberUnitsLeftOut -= env.statistics->selectedBySine;
 
   UnitList::destroy(units);
   units=0;
-  UnitList::pushFromIterator(Stack<Unit*>::Iterator(_unitsWithoutSymbols), units);
+  UnitList::pushFromIterator(Stack<Unit*>::Iterator(unitsWithoutSymbols), units);
   while (selectedStack.isNonEmpty()) {
     UnitList::push(selectedStack.pop(), units);
   }
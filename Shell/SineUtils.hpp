@@ -18,6 +18,7 @@
 #include "Forwards.hpp"
 
 #include "Lib/DArray.hpp"
+#include "Lib/ScopedPtr.hpp"
 #include "Lib/Stack.hpp"
 
 namespace Shell {
@@ -58,11 +59,71 @@ protected:
   SineSymbolExtractor _symExtr;
 };
 
+/**
+ * The part of the SInE selection that does not depend on its parameters:
+ * the symbols of every unit, their generality, and for every symbol the units
+ * it occurs in, each with the generality of its least general symbol.
+ *
+ * Whether a symbol triggers a unit for a given tolerance and generality threshold
+ * only depends on these two generality values, so the D-relation of any SInE setting
+ * can be read off the index without going through the formulas again.
+ */
+class SineTriggerIndex
+  : public SineBase
+{
+public:
+  typedef SineSymbolExtractor::SymId SymId;
+
+  struct Occurrence {
+    /** the position of the unit in the indexed units */
+    unsigned unit;
+    /** the generality of the least general symbol of the unit */
+    unsigned leastGenerality;
+  };
+
+  /**
+   * Return the index of @b units.
+   *
+   * The last index built is kept and returned again for the same units in the same order,
+   * e.g. to the SInE levels and the SInE selection of one preprocessing, or to the portfolio
+   * slices forked after the portfolio process has built it.
+   */
+  static SineTriggerIndex& forUnits(UnitList* units);
+
+  unsigned unitCount() const { return _units.size(); }
+  Unit* unit(unsigned i) const { return _units[i]; }
+  SymId symIdBound() const { return _gen.size(); }
+  unsigned generality(SymId sym) const { return _gen[sym]; }
+
+  /** The symbols of the @b i-th unit, in the order of SineSymbolExtractor::extractSymIds */
+  unsigned symbolCount(unsigned i) const { return _unitSymbolsStart[i+1] - _unitSymbolsStart[i]; }
+  SymId symbol(unsigned i, unsigned j) const { return _unitSymbols[_unitSymbolsStart[i] + j]; }
+
+  /** The occurrences of @b sym, the units in the reverse order */
+  unsigned occurrenceCount(SymId sym) const { return _gen[sym]; }
+  const Occurrence& occurrence(SymId sym, unsigned j) const { return _occurrences[_occurrencesStart[sym] + j]; }
+
+private:
+  explicit SineTriggerIndex(UnitList* units);
+
+  bool indexes(UnitList* units) const;
+
+  Stack<Unit*> _units;
+  Stack<unsigned> _unitNumbers;
+  /** the symbols of the i-th unit are at [_unitSymbolsStart[i], _unitSymbolsStart[i+1]) of _unitSymbols */
+  Stack<SymId> _unitSymbols;
+  Stack<unsigned> _unitSymbolsStart;
+  /** the occurrences of a symbol sym are at [_occurrencesStart[sym], _occurrencesStart[sym] + _gen[sym]) of _occurrences */
+  DArray<Occurrence> _occurrences;
+  DArray<unsigned> _occurrencesStart;
+
+  static ScopedPtr<SineTriggerIndex> s_cached;
+};
+
 /**
  * Class that performs the SInE axiom selection on a single problem
  */
 class SineSelector
-  : public SineBase
 {
 public:
   SineSelector(const Options& opt);
@@ -72,16 +133,13 @@ public:
   bool perform(UnitList*& units); // returns true iff removed something
   void perform(Problem& prb);
 
-  ~SineSelector() {
-    DArray<UnitList*>::Iterator it(_def);
-    while (it.hasNext()) {
-      UnitList::destroy(it.next());
-    }
-  }
 private:
+  typedef SineSymbolExtractor::SymId SymId;
+
   void init();
 
-  void updateDefRelation(Unit* u);
+  /** Does @b sym trigger a unit whose least general symbol has generality @b leastGenerality? */
+  bool triggers(const SineTriggerIndex& index, SymId sym, unsigned leastGenerality) const;
 
   bool _onIncluded;
   bool _strict;
@@ -90,16 +148,6 @@ private:
   unsigned _depthLimit;
 
   bool _justForSineLevels;
-
-  /** Stored the D-relation */
-  DArray<UnitList*> _def;
-
-  /**
-   * Stored formulas that don't contain any symbols
-   *
-   * These formulas are always selected.
-   */
-  Stack<Unit*> _unitsWithoutSymbols;
 };
 
 
@@ -15,12 +15,14 @@
  */
 
 #include <iostream>
+#include <sstream>
 
 #include "Debug/RuntimeStatistics.hpp"
 
 #include "Lib/Environment.hpp"
 #include "Lib/Timer.hpp"
 #include "Lib/Allocator.hpp"
+#include "Kernel/Clause.hpp"
 #include "SAT/Z3Interfacing.hpp"
 
 #include "Shell/UIHelper.hpp"
@@ -141,12 +143,15 @@ void Statistics::print(std::ostream& out)
 
   HEADING("Saturation",activeClauses+passiveClauses+extensionalityClauses+
       generatedClauses+finalActiveClauses+finalPassiveClauses+finalExtensionalityClauses+
-      discardedNonRedundantClauses+inferencesSkippedDueToColors+inferencesBlockedForOrderingAftercheck);
+      discardedNonRedundantClauses+inferencesSkippedDueToColors+inferencesBlockedForOrderingAftercheck+
+      backwardSubsumptionCandidatesFiltered+forwardSubsumptionCandidates+spilledPassiveClauses+
+      orderingCacheHits+orderingCacheMisses);
   COND_OUT("Initial clauses", initialClauses);
   COND_OUT("Generated clauses", generatedClauses);
   COND_OUT("Activations started", activations);
   COND_OUT("Active clauses", activeClauses);
   COND_OUT("Passive clauses", passiveClauses);
+  COND_OUT("Passive clauses spilled to disk", spilledPassiveClauses);
   COND_OUT("Extensionality clauses", extensionalityClauses);
   COND_OUT("Final active clauses", finalActiveClauses);
   COND_OUT("Final passive clauses", finalPassiveClauses);
@@ -154,6 +159,10 @@ void Statistics::print(std::ostream& out)
   COND_OUT("Discarded non-redundant clauses", discardedNonRedundantClauses);
   COND_OUT("Inferences skipped due to colors", inferencesSkippedDueToColors);
   COND_OUT("Inferences blocked due to ordering aftercheck", inferencesBlockedForOrderingAftercheck);
+  COND_OUT("Bw subsumption candidates ruled out by feature vectors", backwardSubsumptionCandidatesFiltered);
+  COND_OUT("Fw subsumption candidates from feature vectors", forwardSubsumptionCandidates);
+  COND_OUT("Ordering cache hits", orderingCacheHits);
+  COND_OUT("Ordering cache misses", orderingCacheMisses);
   SEPARATOR;
 
 
@@ -197,7 +206,7 @@ void Statistics::print(std::ostream& out)
   SEPARATOR;
 
   HEADING("Deletion Inferences",simpleTautologies+equationalTautologies+
-      forwardSubsumed+backwardSubsumed+forwardDemodulationsToEqTaut+
+      forwardSubsumed+backwardSubsumed+variantDuplicates+forwardDemodulationsToEqTaut+
       forwardSubsumptionDemodulationsToEqTaut+backwardSubsumptionDemodulationsToEqTaut+
       backwardDemodulationsToEqTaut+innerRewritesToEqTaut);
   COND_OUT("Simple tautologies", simpleTautologies);
@@ -205,6 +214,7 @@ void Statistics::print(std::ostream& out)
   COND_OUT("Deep equational tautologies", deepEquationalTautologies);
   COND_OUT("Forward subsumptions", forwardSubsumed);
   COND_OUT("Backward subsumptions", backwardSubsumed);
+  COND_OUT("Variant duplicates", variantDuplicates);
   COND_OUT("Fw demodulations to eq. taut.", forwardDemodulationsToEqTaut);
   COND_OUT("Bw demodulations to eq. taut.", backwardDemodulationsToEqTaut);
   COND_OUT("Fw subsumption demodulations to eq. taut.", forwardSubsumptionDemodulationsToEqTaut);
@@ -356,6 +366,49 @@ void Statistics::print(std::ostream& out)
     TimeTrace::instance().printPretty(out);
   }
 #endif // VTIME_PROFILING
+
+  if (env.options && env.options->memoryStatistics()) {
+    printMemory(out);
+  }
+  if (env.options && env.options->indexStatistics()) {
+    // during saturation (e.g. when the time limit interrupts it) take them from the running algorithm,
+    // afterwards the algorithm is gone and has left them in finalIndexStatistics
+    SaturationAlgorithm* salg = SaturationAlgorithm::tryGetInstance();
+    if (salg) {
+      std::ostringstream report;
+      salg->getIndexManager()->printStatistics(report);
+      printCommented(out, report.str());
+    } else {
+      printCommented(out, finalIndexStatistics);
+    }
+  }
+}
+
+/**
+ * Print where the memory goes: the occupancy of the allocators and the memory in use by each kind of object.
+ * Can be called at any time, to see how the memory use develops.
+ */
+void Statistics::printMemory(std::ostream& out)
+{
+  std::ostringstream report;
+  report << "Memory statistics after " << activations << " activations"
+      << " (peak usage " << (Lib::peakMemoryUsageKB() >> 10) << " MB)" << endl;
+  Lib::printAllocationStatistics(report);
+  Kernel::Clause::printAllocatorStatistics(report);
+  printCommented(out, report.str());
+}
+
+/**
+ * Print a multi-line report, with each line commented out as the rest of the statistics.
+ */
+void Statistics::printCommented(std::ostream& out, const std::string& report)
+{
+  std::istringstream lines(report);
+  std::string line;
+  while (std::getline(lines, line)) {
+    addCommentSignForSZS(out);
+    out << line << endl;
+  }
 }
 
 const char* Statistics::phaseToString(ExecutionPhase p)
@@ -18,6 +18,7 @@
 #define __Statistics__
 
 #include <ostream>
+#include <string>
 
 #include "Forwards.hpp"
 #include "Lib/Timer.hpp"
@@ -104,6 +105,8 @@ class Statistics {
 public:
 
   void print(std::ostream& out);
+  void printMemory(std::ostream& out);
+  static void printCommented(std::ostream& out, const std::string& report);
   void explainRefutationNotFound(std::ostream& out);
 
   // Input
@@ -296,6 +299,8 @@ public:
   unsigned forwardSubsumed = 0;
   /** number of backward subsumed clauses */
   unsigned backwardSubsumed = 0;
+  /** number of new clauses dropped as variants of kept clauses */
+  unsigned variantDuplicates = 0;
 
   /** statistics of term algebra rules */
   unsigned taDistinctnessSimplifications = 0;
@@ -311,6 +316,8 @@ public:
   unsigned generatedClauses = 0;
   /** all passive clauses */
   unsigned passiveClauses = 0;
+  /** passive clauses written to the spill file, each time they were */
+  unsigned spilledPassiveClauses = 0;
   /** all active clauses */
   unsigned activeClauses = 0;
   /** all extensionality clauses */
@@ -319,6 +326,14 @@ public:
   unsigned discardedNonRedundantClauses = 0;
 
   unsigned inferencesBlockedForOrderingAftercheck = 0;
+  /** backward subsumption (resolution) candidates rejected by comparing feature vectors */
+  unsigned backwardSubsumptionCandidatesFiltered = 0;
+  /** forward subsumption (resolution) candidates retrieved from the feature vector index */
+  unsigned forwardSubsumptionCandidates = 0;
+  /** comparisons of shared terms answered by the ordering result cache */
+  unsigned orderingCacheHits = 0;
+  /** comparisons of shared terms looked up in the ordering result cache and not found */
+  unsigned orderingCacheMisses = 0;
 
   bool smtReturnedUnknown = false;
   bool smtDidNotEvaluate = false;
@@ -383,6 +398,8 @@ public:
   /** if problem is satisfiable and we obtained a model, contains its
    * representation; otherwise it is an empty string */
   std::string model;
+  /** the index statistics taken when the saturation algorithm ended (see the option index_statistics) */
+  std::string finalIndexStatistics;
 
   ExecutionPhase phase = ExecutionPhase::INITIALIZATION;
 
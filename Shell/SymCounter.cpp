@@ -41,17 +41,17 @@ SymCounter::SymCounter (Signature& sig)
   _noOfTypeCons(sig.typeCons())
 {
   if (_noOfPreds) {
-    void* mem = ALLOC_KNOWN(_noOfPreds*sizeof(Pred),"SymCounter::Pred[]");
+    void* mem = ALLOC_KNOWN(_noOfPreds*sizeof(Pred),"Shell::SymCounter::Pred");
     _preds = array_new<Pred>(mem, _noOfPreds);
   }
 
   if (_noOfFuns) {
-    void* mem = ALLOC_KNOWN(_noOfFuns*sizeof(FunOrTypeCon),"SymCounter::Fun[]");
+    void* mem = ALLOC_KNOWN(_noOfFuns*sizeof(FunOrTypeCon),"Shell::SymCounter::Fun");
     _funs = array_new<FunOrTypeCon>(mem, _noOfFuns);
   }
 
   if (_noOfTypeCons) {
-    void* mem = ALLOC_KNOWN(_noOfTypeCons*sizeof(FunOrTypeCon),"SymCounter::TypeCon[]");
+    void* mem = ALLOC_KNOWN(_noOfTypeCons*sizeof(FunOrTypeCon),"Shell::SymCounter::TypeCon");
     _typeCons = array_new<FunOrTypeCon>(mem, _noOfTypeCons);
   }  
 } // SymCounter::SymCounter
@@ -65,15 +65,15 @@ SymCounter::~SymCounter ()
 {
   if (_noOfPreds) {
     array_delete(_preds,_noOfPreds);
-    DEALLOC_KNOWN(_preds,_noOfPreds*sizeof(Pred),"SymCounter::Pred[]");
+    DEALLOC_KNOWN(_preds,_noOfPreds*sizeof(Pred),"Shell::SymCounter::Pred");
   }
   if (_noOfFuns) {
     array_delete(_funs,_noOfFuns);
-    DEALLOC_KNOWN(_funs,_noOfFuns*sizeof(FunOrTypeCon),"SymCounter::Fun[]");
+    DEALLOC_KNOWN(_funs,_noOfFuns*sizeof(FunOrTypeCon),"Shell::SymCounter::Fun");
   }
   if (_noOfTypeCons) {
     array_delete(_typeCons,_noOfTypeCons);
-    DEALLOC_KNOWN(_typeCons,_noOfTypeCons*sizeof(FunOrTypeCon),"SymCounter::TypeCon[]");
+    DEALLOC_KNOWN(_typeCons,_noOfTypeCons*sizeof(FunOrTypeCon),"Shell::SymCounter::TypeCon");
   }
 } // SymCounter::~SymCounter
 
@@ -35,6 +35,7 @@
 #include "Parse/TPTP.hpp"
 
 #include "AnswerLiteralManager.hpp"
+#include "AxiomSnapshot.hpp"
 #include "InterpolantMinimizer.hpp"
 #include "Interpolants.hpp"
 #include "LaTeX.hpp"
@@ -132,10 +133,32 @@ bool UIHelper::s_expecting_sat=false;
 bool UIHelper::s_expecting_unsat=false;
 
 bool UIHelper::portfolioParent=false;
+int UIHelper::progressReportFd=-1;
 bool UIHelper::satisfiableStatusWasAlreadyOutput=false;
 
 bool UIHelper::spiderOutputDone = false;
 
+/**
+ * Send a ProgressReport to progressReportFd, unless we have sent one less than a second ago.
+ */
+void UIHelper::reportProgress()
+{
+  ASS_GE(progressReportFd, 0);
+
+  static long lastReport = 0;
+  long now = Timer::elapsedMilliseconds();
+  if (now - lastReport < 1000) {
+    return;
+  }
+  lastReport = now;
+
+  ProgressReport report { getpid(), env.statistics->activations, peakMemoryUsageKB() };
+  // writes this small are atomic, so the reports of the workers sharing the pipe do not get mixed up;
+  // if the pipe is full (it is non-blocking), the report is simply lost
+  ssize_t res = ::write(progressReportFd, &report, sizeof(report));
+  (void)res;
+}
+
 void UIHelper::outputAllPremises(std::ostream& out, UnitList* units, std::string prefix)
 {
 #if 1
@@ -359,6 +382,14 @@ void UIHelper::parseFile(const std::string& inputFile, Options::InputSyntax inpu
   }
 }
 
+void UIHelper::loadAxiomSnapshot(const std::string& fileName)
+{
+  TIME_TRACE(TimeTrace::PARSING);
+  ScopedLet<ExecutionPhase> localAssing(env.statistics->phase,ExecutionPhase::PARSING);
+
+  AxiomSnapshot::load(fileName, _loadedPieces.top()._units);
+}
+
 /**
  * After a single call (or a series of calls) to parse* functions,
  * return a problem object with the obtained units.
@@ -16,6 +16,7 @@
 #define __UIHelper__
 
 #include <ostream>
+#include <sys/types.h>
 
 #include "Forwards.hpp"
 #include "Options.hpp"
@@ -53,6 +54,8 @@ public:
   static void parseStream(std::istream& input, Options::InputSyntax inputSyntax, bool verbose, bool preferSMTonAuto);
   static void parseStandardInput(Options::InputSyntax inputSyntax);
   static void parseFile(const std::string& inputFile, Options::InputSyntax inputSyntax, bool verbose);
+  /** Add the clauses of an axiom snapshot (see AxiomSnapshot) to the parsed units */
+  static void loadAxiomSnapshot(const std::string& fileName);
 
   static Problem* getInputProblem();
 
@@ -83,6 +86,19 @@ public:
    * Currently affects how things are reported during timeout (see Timer.cpp)
    */
   static bool portfolioParent;
+
+  /**
+   * What a portfolio worker periodically tells the portfolio process about its progress
+   * (see PortfolioMode::readProgressReports)
+   */
+  struct ProgressReport {
+    pid_t pid;
+    unsigned activations;
+    long memoryKB;
+  };
+  /** Where a portfolio worker sends its progress reports (-1 if nowhere) */
+  static int progressReportFd;
+  static void reportProgress();
   /**
    * Hack not to output satisfiable status twice (we may output it earlier in
    * FiniteModelBuilder, before we start generating model)
@@ -0,0 +1,112 @@
+/*
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ */
+#include <algorithm>
+#include <random>
+#include <sstream>
+#include <vector>
+
+#include "Lib/Allocator.hpp"
+#include "Test/UnitTesting.hpp"
+
+#ifndef INDIVIDUAL_ALLOCATIONS
+
+using Lib::FixedSizeAllocator;
+using Chunks = std::vector<void*>;
+
+// enough chunks for several blocks of the allocator
+static const unsigned CHUNKS = 5000;
+
+template<class FSA>
+static Chunks allocate(FSA& fsa, unsigned n)
+{
+  Chunks res;
+  for (unsigned i = 0; i < n; i++) {
+    res.push_back(fsa.alloc());
+  }
+  return res;
+}
+
+TEST_FUN(compact_orders_free_list)
+{
+  FixedSizeAllocator<16> fsa;
+  Chunks chunks = allocate(fsa, CHUNKS);
+  std::shuffle(chunks.begin(), chunks.end(), std::mt19937(0));
+  for (unsigned i = 0; i < CHUNKS / 2; i++) {
+    fsa.free(chunks[i]);
+  }
+
+  ASS_EQ(fsa.compact(false), 0);
+  Chunks reused = allocate(fsa, CHUNKS / 2);
+  ASS(std::is_sorted(reused.begin(), reused.end()));
+  std::sort(chunks.begin(), chunks.begin() + CHUNKS / 2);
+  ASS(std::equal(reused.begin(), reused.end(), chunks.begin()));
+}
+
+TEST_FUN(compact_releases_empty_blocks)
+{
+  FixedSizeAllocator<16> fsa;
+  Chunks chunks = allocate(fsa, CHUNKS);
+  // nothing to release while everything is live
+  ASS_EQ(fsa.compact(true), 0);
+
+  // keep every other chunk of the first half, free all the rest
+  Chunks live;
+  for (unsigned i = 0; i < CHUNKS; i++) {
+    if (i < CHUNKS / 2 && i % 2 == 0) {
+      live.push_back(chunks[i]);
+    }
+    else {
+      fsa.free(chunks[i]);
+    }
+  }
+  // only the blocks of the second half can go, but not the current one
+  size_t released = fsa.compact(true);
+  ALWAYS(released > 0);
+  ALWAYS(released <= CHUNKS / 2 / 1024);
+
+  // the remaining free chunks are still there to be reused
+  Chunks reused = allocate(fsa, CHUNKS / 4);
+  for (void* c : reused) {
+    NEVER(std::find(live.begin(), live.end(), c) != live.end());
+  }
+  ASS_EQ(fsa.compact(true), 0);
+}
+
+TEST_FUN(size_class_statistics)
+{
+  FixedSizeAllocator<16> fsa;
+  Chunks chunks = allocate(fsa, CHUNKS);
+  for (unsigned i = 0; i < 100; i++) {
+    fsa.free(chunks[i]);
+  }
+  Lib::SizeClassStatistics stats = fsa.statistics();
+  ASS_EQ(stats.size, 16);
+  ASS_EQ(stats.blocks, CHUNKS / 1024 + 1);
+  ASS_EQ(stats.live, CHUNKS - 100);
+  ASS_EQ(stats.free, 100);
+}
+
+#if VALLOCATION_STATISTICS
+struct CountedObject {
+  USE_ALLOCATOR(CountedObject)
+  char payload[40];
+};
+
+TEST_FUN(memory_by_kind)
+{
+  CountedObject* obj = new CountedObject;
+  std::ostringstream out;
+  Lib::printAllocationStatistics(out);
+  ASS(out.str().find("CountedObject: ") != std::string::npos);
+  delete obj;
+}
+#endif // VALLOCATION_STATISTICS
+
+#endif
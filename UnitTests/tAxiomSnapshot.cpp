@@ -0,0 +1,56 @@
+/*
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ */
+#include <cstdio>
+#include <cstdlib>
+#include <unistd.h>
+
+#include "Test/UnitTesting.hpp"
+#include "Test/SyntaxSugar.hpp"
+
+#include "Shell/AxiomSnapshot.hpp"
+
+using namespace Shell;
+
+TEST_FUN(save_and_load)
+{
+  DECL_DEFAULT_VARS
+  DECL_SORT(s)
+  DECL_SORT(t)
+  DECL_CONST(c, s)
+  DECL_FUNC(f, {s, t}, s)
+  DECL_FUNC(g, {s}, t)
+  DECL_PRED(p, {s})
+  DECL_PRED(q, {s, t})
+
+  Stack<Clause*> clauses = {
+    clause({ p(c), ~q(x, g(x)) }),
+    clause({ f(x, g(c)) == c, p(f(y, g(y))) }),
+    clause({ g(x) != g(c) }),
+  };
+
+  char fileName[] = "/tmp/vampire_snapshot_XXXXXX";
+  close(mkstemp(fileName));
+  AxiomSnapshot::save(fileName, pvi(iterTraits(clauses.iterFifo()).map([](Clause* cl) { return cl; })));
+  UnitList::FIFO loaded;
+  AxiomSnapshot::load(fileName, loaded);
+  std::remove(fileName);
+
+  // the symbols are found in the signature, so the terms are shared with the saved ones
+  unsigned i = 0;
+  for (Unit* u : iterTraits(UnitList::Iterator(loaded.list()))) {
+    Clause* cl = u->asClause();
+    ASS_EQ(cl->length(), clauses[i]->length());
+    for (unsigned j = 0; j < cl->length(); j++) {
+      ASS_EQ((*cl)[j], (*clauses[i])[j]);
+    }
+    i++;
+  }
+  ASS_EQ(i, clauses.size());
+}
@@ -0,0 +1,168 @@
+/*
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ */
+#include "Kernel/BucketClauseQueue.hpp"
+#include "Kernel/Clause.hpp"
+
+#include "Test/UnitTesting.hpp"
+#include "Test/SyntaxSugar.hpp"
+
+using namespace Kernel;
+
+/** Clauses by the first letter of the only predicate, then by the number */
+class TestQueue
+  : public BucketClauseQueue<TestQueue>
+{
+public:
+  std::uint64_t bucketKey(Clause* cl) const { return (*cl)[0]->functor(); }
+  std::uint64_t entryKey(Clause* cl) const { return cl->number(); }
+};
+
+static Stack<Clause*> contents(TestQueue& q)
+{
+  Stack<Clause*> res;
+  TestQueue::Iterator it(q);
+  while (it.hasNext()) {
+    res.push(it.next());
+  }
+  return res;
+}
+
+/** Check that @b q contains exactly @b expected, which are in the order of the queue */
+static void checkContents(TestQueue& q, Stack<Clause*> expected)
+{
+  std::sort(expected.begin(), expected.end(), [&](Clause* c1, Clause* c2) { return q.lessThan(c1, c2); });
+  ASS_EQ(contents(q), expected);
+  ASS_EQ(q.isEmpty(), expected.isEmpty());
+}
+
+TEST_FUN(pop_in_order)
+{
+  DECL_DEFAULT_VARS
+  DECL_SORT(s)
+  DECL_CONST(a, s)
+  DECL_PRED(p, {s})
+  DECL_PRED(q, {s})
+  DECL_PRED(r, {s})
+
+  // created in the order of their numbers
+  Stack<Clause*> cls = { clause({ q(a) }), clause({ r(a) }), clause({ p(a) }), clause({ q(x) }),
+    clause({ p(x) }), clause({ r(x) }), clause({ q(a) }), clause({ p(a) }) };
+
+  TestQueue queue;
+  // insert some of them out of the order within their bucket
+  for (unsigned i : { 0, 1, 3, 7, 5, 2, 6, 4 }) {
+    queue.insert(cls[i]);
+  }
+  checkContents(queue, cls);
+
+  Stack<Clause*> popped;
+  while (!queue.isEmpty()) {
+    popped.push(queue.pop());
+  }
+  Stack<Clause*> expected = cls;
+  std::sort(expected.begin(), expected.end(), [&](Clause* c1, Clause* c2) { return queue.lessThan(c1, c2); });
+  ASS_EQ(popped, expected);
+}
+
+TEST_FUN(remove_and_insert_back)
+{
+  DECL_DEFAULT_VARS
+  DECL_SORT(s)
+  DECL_CONST(a, s)
+  DECL_CONST(b, s)
+  DECL_PRED(p, {s})
+  DECL_PRED(q, {s})
+
+  Stack<Clause*> cls;
+  for (unsigned i = 0; i < 40; i++) {
+    cls.push(clause({ i % 3 ? p(i % 2 ? a : b) : q(x) }));
+  }
+
+  TestQueue queue;
+  Stack<Clause*> in;
+  for (Clause* cl : cls) {
+    queue.insert(cl);
+    in.push(cl);
+  }
+
+  // remove most of them, so that the buckets get compacted
+  for (unsigned i = 0; i < cls.size(); i++) {
+    if (i % 5) {
+      ASS(queue.remove(cls[i]));
+      ASS(!queue.remove(cls[i]));
+      in.remove(cls[i]);
+    }
+  }
+  checkContents(queue, in);
+
+  // insert some of them back
+  for (unsigned i = 0; i < cls.size(); i += 3) {
+    if (i % 5) {
+      queue.insert(cls[i]);
+      in.push(cls[i]);
+    }
+  }
+  checkContents(queue, in);
+
+  // pop a few and insert them back at the front
+  Clause* c1 = queue.pop();
+  Clause* c2 = queue.pop();
+  queue.insert(c2);
+  queue.insert(c1);
+  checkContents(queue, in);
+
+  for (Clause* cl : in) {
+    ASS(queue.remove(cl));
+  }
+  checkContents(queue, Stack<Clause*>());
+}
+
+TEST_FUN(insert_after_destroying_removed)
+{
+  DECL_DEFAULT_VARS
+  DECL_SORT(s)
+  DECL_CONST(a, s)
+  DECL_PRED(p, {s})
+  DECL_PRED(q, {s})
+
+  Stack<Clause*> ps;
+  for (unsigned i = 0; i < 8; i++) {
+    ps.push(clause({ p(a) }));
+  }
+  TestQueue queue;
+  for (Clause* cl : ps) {
+    queue.insert(cl);
+  }
+
+  // removed from the middle of their bucket, they stay there marked as removed
+  ASS(queue.remove(ps[1]));
+  ASS(queue.remove(ps[2]));
+  ps[1]->destroy();
+  ps[2]->destroy();
+  // clauses of another bucket, which may get the memory of the destroyed ones
+  Stack<Clause*> in = { ps[0], ps[3], ps[4], ps[5], ps[6], ps[7], clause({ q(a) }), clause({ q(a) }) };
+  queue.insert(in[6]);
+  queue.insert(in[7]);
+  checkContents(queue, in);
+
+  // insert back into the bucket of p in front of its last clause and at its front,
+  // which searches the bucket past the entries of the destroyed clauses
+  ASS(queue.remove(ps[5]));
+  queue.insert(ps[5]);
+  checkContents(queue, in);
+  ASS_EQ(queue.pop(), ps[0]);
+  queue.insert(ps[0]);
+  checkContents(queue, in);
+
+  for (Clause* cl : in) {
+    ASS(queue.remove(cl));
+  }
+  ASS(queue.isEmpty());
+}
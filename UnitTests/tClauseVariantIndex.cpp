@@ -0,0 +1,98 @@
+/*
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ */
+#include "Indexing/ClauseVariantIndex.hpp"
+#include "Kernel/Clause.hpp"
+
+#include "Test/UnitTesting.hpp"
+#include "Test/SyntaxSugar.hpp"
+
+using namespace Kernel;
+using namespace Indexing;
+
+#define DECL_SIGNATURE                                                          \
+  DECL_DEFAULT_VARS                                                             \
+  DECL_VAR(x3, 3)                                                               \
+  DECL_VAR(x4, 4)                                                               \
+  DECL_SORT(s)                                                                  \
+  DECL_CONST(a, s)                                                              \
+  DECL_FUNC(f, {s}, s)                                                          \
+  DECL_FUNC(g, {s, s}, s)                                                       \
+  DECL_PRED(p, {s, s})                                                          \
+  DECL_PRED(q, {s})                                                             \
+  DECL_PRED(r, {s})
+
+TEST_FUN(variant_hash_of_renamed_variables)
+{
+  DECL_SIGNATURE
+
+  ASS_EQ(clause({ p(f(x), y), ~q(g(y, x)) })->variantHash(),
+         clause({ p(f(x4), x3), ~q(g(x3, x4)) })->variantHash())
+  ASS_EQ(clause({ p(x, y), q(z) })->variantHash(),
+         clause({ p(z, x), q(y) })->variantHash())
+  // variables occurring a different number of times
+  ASS_NEQ(clause({ p(f(x), y) })->variantHash(),
+          clause({ p(f(x), x) })->variantHash())
+}
+
+TEST_FUN(variant_hash_of_reordered_literals)
+{
+  DECL_SIGNATURE
+
+  ASS_EQ(clause({ p(x, a), ~q(f(x)), r(a) })->variantHash(),
+         clause({ r(a), p(y, a), ~q(f(y)) })->variantHash())
+  ASS_EQ(clause({ q(x), ~q(f(x)), ~r(y) })->variantHash(),
+         clause({ ~r(x), ~q(f(y)), q(y) })->variantHash())
+}
+
+TEST_FUN(variant_hash_of_reoriented_equalities)
+{
+  DECL_SIGNATURE
+
+  ASS_EQ(clause({ f(x) == y, q(y) })->variantHash(),
+         clause({ x3 == f(x4), q(x3) })->variantHash())
+  ASS_EQ(clause({ g(x, a) != f(y), r(x) })->variantHash(),
+         clause({ r(z), f(x) != g(z, a) })->variantHash())
+  ASS_EQ(clause({ sorted(x, s) == y, p(x, f(y)) })->variantHash(),
+         clause({ p(y, f(x)), sorted(x, s) == y })->variantHash())
+}
+
+TEST_FUN(variant_hash_of_literals)
+{
+  DECL_SIGNATURE
+
+  // the hash of a clause is computed from its literals and cached
+  Clause* cl = clause({ p(x, f(y)), ~q(g(y, a)), f(x) == a });
+  Literal* lits[] = { (*cl)[2], (*cl)[0], (*cl)[1] };
+  ASS_EQ(Clause::variantHash(lits, 3), cl->variantHash())
+  ASS_EQ(cl->variantHash(), cl->variantHash())
+  ASS_NEQ(cl->variantHash(), 0u)
+}
+
+TEST_FUN(stored_variants)
+{
+  DECL_SIGNATURE
+
+  StoredClauseVariantIndex index;
+  Clause* stored = clause({ p(x, f(y)), ~q(g(y, a)) });
+  stored->setStore(Clause::PASSIVE);
+  index.insert(stored);
+  ASS_EQ(stored->refCnt(), 1u)
+
+  Clause* variant = clause({ ~q(g(x, a)), p(y, f(x)) });
+  Clause* other = clause({ p(x, f(x)), ~q(g(x, a)) });
+  ASS(index.retrieveVariants(variant).hasNext())
+  ASS(!index.retrieveVariants(other).hasNext())
+
+  // the reference is released as soon as the clause leaves
+  index.remove(stored);
+  ASS_EQ(stored->refCnt(), 0u)
+  ASS(!index.retrieveVariants(variant).hasNext())
+  stored->setStore(Clause::NONE);
+}
@@ -0,0 +1,253 @@
+/*
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ */
+#include "Kernel/Clause.hpp"
+#include "Kernel/CompactClause.hpp"
+#include "Lib/Environment.hpp"
+#include "Lib/Sys/SpillFile.hpp"
+#include "Saturation/AWPassiveClauseContainers.hpp"
+#include "Shell/Options.hpp"
+#include "Shell/Statistics.hpp"
+
+#include "Test/UnitTesting.hpp"
+#include "Test/SyntaxSugar.hpp"
+
+using namespace Kernel;
+using namespace Saturation;
+using namespace Shell;
+
+TEST_FUN(materialize_and_destroy)
+{
+  DECL_DEFAULT_VARS
+  DECL_SORT(s)
+  DECL_CONST(a, s)
+  DECL_FUNC(f, {s}, s)
+  DECL_PRED(p, {s})
+
+  Clause* parent = clause({ p(f(x)), ~p(a) });
+  // only the clauses derived after preprocessing can be compact
+  Unit::onPreprocessingEnd();
+
+  Clause* cl = Clause::fromLiterals({ p(f(a)), ~p(f(y)) }, GeneratingInference1(InferenceRule::RESOLUTION, parent));
+  cl->setAge(3);
+  Literal* l0 = (*cl)[0];
+  Literal* l1 = (*cl)[1];
+  unsigned number = cl->number();
+  unsigned weight = cl->weight();
+  unsigned wfcs = cl->weightForClauseSelection(*env.options);
+  ASS_EQ(parent->refCnt(), 1u);
+  ASS(CompactClause::canCompact(cl));
+
+  CompactClause* ccl = CompactClause::fromClause(cl, *env.options);
+  ASS_EQ(ccl->number(), number);
+  ASS_EQ(ccl->age(), 3u);
+  ASS_EQ(ccl->length(), 2u);
+  ASS_EQ(ccl->weight(), weight);
+  ASS_EQ(ccl->weightForClauseSelection(*env.options), wfcs);
+  ASS_EQ((*ccl)[1], l1);
+  // the compact clause refers to the parent instead of the clause
+  ASS_EQ(parent->refCnt(), 1u);
+
+  cl = ccl->materialize();
+  ASS_EQ(cl->number(), number);
+  ASS_EQ(cl->age(), 3u);
+  ASS_EQ(cl->length(), 2u);
+  ASS_EQ((*cl)[0], l0);
+  ASS_EQ((*cl)[1], l1);
+  ASS_EQ(cl->weightForClauseSelection(*env.options), wfcs);
+  ASS(cl->inference().rule() == InferenceRule::RESOLUTION);
+  ASS_EQ(parent->refCnt(), 1u);
+  cl->setStore(Clause::PASSIVE);
+
+  // a clause referred to cannot be compact
+  cl->incRefCnt();
+  ASS(!CompactClause::canCompact(cl));
+  cl->decRefCnt();
+
+  CompactClause::fromClause(cl, *env.options)->destroy();
+  ASS_EQ(parent->refCnt(), 0u);
+}
+
+TEST_FUN(spill_and_read_back)
+{
+  DECL_DEFAULT_VARS
+  DECL_SORT(s)
+  DECL_CONST(a, s)
+  DECL_FUNC(f, {s}, s)
+  DECL_PRED(p, {s})
+
+  Clause* parent = clause({ p(f(x)), ~p(a) });
+  Unit::onPreprocessingEnd();
+
+  Stack<Clause*> cls = { Clause::fromLiterals({ p(f(a)) }, GeneratingInference1(InferenceRule::RESOLUTION, parent)),
+    Clause::fromLiterals({ p(f(a)), ~p(f(y)), p(x) }, GeneratingInference1(InferenceRule::FACTORING, parent)) };
+  Stack<unsigned> numbers;
+  Stack<Literal*> lits;
+  Lib::Sys::SpillFile file;
+  for (Clause* cl : cls) {
+    numbers.push(cl->number());
+    lits.push((*cl)[cl->length() - 1]);
+    CompactClause* ccl = CompactClause::fromClause(cl, *env.options);
+    file.append(ccl, ccl->bytes());
+    // the references to the parent go with the bytes
+    ccl->deallocate();
+  }
+  ASS_EQ(parent->refCnt(), 2u);
+
+  const char* start = file.map();
+  const char* data = start;
+  for (unsigned i = 0; i < cls.size(); i++) {
+    CompactClause* ccl = CompactClause::fromBytes(data);
+    data += ccl->bytes();
+    ASS_EQ(ccl->number(), numbers[i]);
+    ASS_EQ((*ccl)[ccl->length() - 1], lits[i]);
+    ccl->destroy();
+  }
+  ASS(data == start + file.size());
+  ASS_EQ(parent->refCnt(), 0u);
+
+  file.clear();
+  ASS_EQ(file.size(), 0u);
+}
+
+TEST_FUN(select_from_compact_queues)
+{
+  DECL_DEFAULT_VARS
+  DECL_SORT(s)
+  DECL_CONST(a, s)
+  DECL_FUNC(f, {s}, s)
+  DECL_PRED(p, {s})
+
+  Clause* parent = clause({ p(f(x)), ~p(a) });
+  Unit::onPreprocessingEnd();
+
+  AgeQueue ageOrder(*env.options);
+  WeightQueue weightOrder(*env.options);
+  CompactClauseQueue<AgeQueue> ageQueue(ageOrder);
+  CompactClauseQueue<WeightQueue> weightQueue(weightOrder);
+  auto add = [&](unsigned age) {
+    Clause* cl = Clause::fromLiterals({ p(f(a)) }, GeneratingInference1(InferenceRule::RESOLUTION, parent));
+    cl->setAge(age);
+    CompactClause* ccl = CompactClause::fromClause(cl, *env.options);
+    ageQueue.insert(ccl);
+    weightQueue.insert(ccl);
+  };
+
+  // one bucket in each queue
+  for (unsigned i = 0; i < 6; i++) {
+    add(2);
+  }
+  // select two by weight as AWPassiveClauseContainer::popSelected does:
+  // the age queue keeps removed entries of the compact clauses freed by materializing them
+  for (unsigned i = 0; i < 2; i++) {
+    CompactClause* ccl = weightQueue.pop();
+    ASS(ageQueue.remove(ccl));
+    ccl->materialize()->destroy();
+  }
+  // new compact clauses, which may get the memory of the freed ones, at the end and at the front of the bucket
+  add(2);
+  add(1);
+
+  // select the rest by age
+  unsigned selected = 0;
+  unsigned lastAge = 0;
+  unsigned lastNumber = 0;
+  while (!ageQueue.isEmpty()) {
+    CompactClause* ccl = ageQueue.pop();
+    ASS(ccl->age() > lastAge || (ccl->age() == lastAge && ccl->number() > lastNumber));
+    lastAge = ccl->age();
+    lastNumber = ccl->number();
+    ASS(weightQueue.remove(ccl));
+    ccl->destroy();
+    selected++;
+  }
+  ASS_EQ(selected, 6u);
+  ASS(weightQueue.isEmpty());
+  ASS_EQ(parent->refCnt(), 0u);
+}
+
+/**
+ * Select all the clauses from a container which spills them and from one which
+ * does not, and check that they come in the same order.
+ */
+TEST_FUN(spilled_selection_order)
+{
+  DECL_DEFAULT_VARS
+  DECL_SORT(s)
+  DECL_CONST(a, s)
+  DECL_FUNC(f, {s}, s)
+  DECL_PRED(p, {s})
+
+  Clause* parent = clause({ p(f(x)), ~p(a) });
+  Unit::onPreprocessingEnd();
+
+  Options opt;
+  opt.set("saturation_algorithm", "discount");
+  opt.set("compact_passive", "on");
+  Options spillOpt;
+  spillOpt.set("saturation_algorithm", "discount");
+  spillOpt.set("compact_passive", "on");
+  spillOpt.set("passive_spill_memory", "1");
+  AWPassiveClauseContainer passive(true, opt, "passive");
+  AWPassiveClauseContainer spilling(true, spillOpt, "spilling");
+  ASS(spilling.compactsClauses());
+
+  Stack<TermSugar> terms;
+  terms.push(a);
+  for (unsigned i = 1; i < 40; i++) {
+    terms.push(f(terms.top()));
+  }
+  unsigned seed = 1;
+  auto next = [&](unsigned bound) {
+    seed = seed * 1103515245 + 12345;
+    return (seed >> 16) % bound;
+  };
+  auto add = [&](AWPassiveClauseContainer& container, unsigned n) {
+    for (unsigned i = 0; i < n; i++) {
+      Clause* cl = Clause::fromLiterals({ p(terms[next(terms.size())]) }, GeneratingInference1(InferenceRule::RESOLUTION, parent));
+      cl->setAge(next(100));
+      cl->setStore(Clause::PASSIVE);
+      cl->incRefCnt(); // the reference of the saturation algorithm, which the compact form drops
+      container.add(cl);
+    }
+  };
+  auto select = [](AWPassiveClauseContainer& container, unsigned n, Stack<unsigned>& selected) {
+    for (unsigned i = 0; i < n; i++) {
+      Clause* cl = container.popSelected();
+      selected.push(cl->number());
+      cl->setStore(Clause::NONE);
+      cl->decRefCnt();
+    }
+  };
+
+  // spilled in several rounds, read back in parts, and added to in between
+  unsigned spilledBefore = env.statistics->spilledPassiveClauses;
+  Stack<unsigned> expected;
+  Stack<unsigned> actual;
+  unsigned seedBefore = seed;
+  add(passive, 40000);
+  select(passive, 20000, expected);
+  add(passive, 20000);
+  select(passive, 40000, expected);
+  seed = seedBefore;
+  add(spilling, 40000);
+  select(spilling, 20000, actual);
+  add(spilling, 20000);
+  select(spilling, 40000, actual);
+  ASS_G(env.statistics->spilledPassiveClauses, spilledBefore);
+  ASS(passive.isEmpty());
+  ASS(spilling.isEmpty());
+
+  // the clauses added to the second container are numbered the same way after those of the first one
+  ASS_EQ(actual.size(), expected.size());
+  for (unsigned i = 0; i < expected.size(); i++) {
+    ASS_EQ(actual[i] - expected[i], actual[0] - expected[0]);
+  }
+  ASS_EQ(parent->refCnt(), 0u);
+}
@@ -0,0 +1,155 @@
+/*
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ */
+#include "Test/UnitTesting.hpp"
+#include "Test/SyntaxSugar.hpp"
+
+#include "Indexing/FeatureVectorIndex.hpp"
+#include "Saturation/ClauseContainer.hpp"
+
+using namespace Indexing;
+
+#define SYNTAX_SUGAR_FEATURE_VECTORS \
+ __ALLOW_UNUSED(                     \
+    DECL_DEFAULT_VARS \
+    DECL_VAR(x1, 1) \
+    DECL_VAR(x2, 2) \
+    DECL_VAR(y1, 11) \
+    DECL_SORT(s) \
+    DECL_CONST(c, s) \
+    DECL_CONST(d, s) \
+    DECL_CONST(e, s) \
+    DECL_FUNC(f, {s}, s) \
+    DECL_FUNC(f2, {s, s}, s) \
+    DECL_PRED(p, {s}) \
+    DECL_PRED(p2, {s, s}) \
+    DECL_PRED(q, {s}) \
+    DECL_PRED(r, {s}) )
+
+static Stack<Clause*> candidates(FwSubsFeatureVectorIndex& index, Clause* query, bool resolution)
+{
+  Stack<Clause*> res;
+  index.visitCandidates(FeatureVector(query), resolution, [&](Clause* cl, const FeatureVector&) {
+    res.push(cl);
+    return false;
+  });
+  return res;
+}
+
+static bool maySubsume(Clause* cl, Clause* instance)
+{ return FeatureVector(cl).maySubsume(FeatureVector(instance)); }
+
+static bool mayResolve(Clause* cl, Clause* instance)
+{ return FeatureVector(cl).mayResolve(FeatureVector(instance)); }
+
+TEST_FUN(subsumption)
+{
+  SYNTAX_SUGAR_FEATURE_VECTORS;
+
+  // subsumed pairs must never be ruled out
+  ASS(maySubsume(clause({ p(x1), q(x2) }), clause({ p(c), q(d), r(e) })));
+  ASS(maySubsume(clause({ p(f(x1)), ~q(x1) }), clause({ ~q(c), p(f(c)), r(f(d)) })));
+  ASS(maySubsume(clause({ p2(x1, f(x2)) }), clause({ p2(f(c), f(f2(c, d))) })));
+  ASS(maySubsume(clause({ p(x1), ~p(x1) }), clause({ p(c), ~p(c) })));
+
+  // too many literals
+  ASS(!maySubsume(clause({ p(x1), q(x2) }), clause({ p(c) })));
+  // wrong polarity
+  ASS(!maySubsume(clause({ ~p(x1) }), clause({ p(c), q(d) })));
+  // a literal with more symbols than any literal of the instance
+  ASS(!maySubsume(clause({ p(f(f(x1))) }), clause({ p(f(c)), q(f(d)) })));
+}
+
+TEST_FUN(subsumption_resolution)
+{
+  SYNTAX_SUGAR_FEATURE_VECTORS;
+
+  // pairs with a subsumption resolution must never be ruled out
+  ASS(mayResolve(clause({ p(x1), q(x2) }), clause({ p(y1), ~q(c) })));
+  ASS(mayResolve(clause({ ~p(x1) }), clause({ p(c), q(d) })));
+  ASS(mayResolve(clause({ p(x1), p(x2) }), clause({ ~p(c) })));
+  ASS(mayResolve(clause({ ~p2(f(x1), x2), q(x2) }), clause({ p2(f(c), d), q(d), r(e) })));
+
+  // a literal with more symbols than any literal of the instance
+  ASS(!mayResolve(clause({ p(f(f(x1))) }), clause({ ~p(f(c)), q(f(d)) })));
+  ASS(!mayResolve(clause({ ~p2(f(x1), f(x2)) }), clause({ p2(f(c), d) })));
+}
+
+TEST_FUN(forward_index)
+{
+  SYNTAX_SUGAR_FEATURE_VECTORS;
+
+  Stack<unsigned> levels = { FeatureVector::POSITIVE_LITERALS, FeatureVector::NEGATIVE_LITERALS, FeatureVector::LITERAL_SYMBOLS };
+  for (unsigned b = 0; b < FeatureVector::SYMBOL_BUCKETS; b++) {
+    levels.push(FeatureVector::POSITIVE_PREDICATES + b);
+  }
+  FwSubsFeatureVectorIndex index(std::move(levels));
+  PlainClauseContainer container;
+  index.attachContainer(&container);
+  ASS(index.isEmpty());
+
+  Clause* c1 = clause({ p(x1) });
+  Clause* c2 = clause({ p(x1), q(x2) });
+  Clause* c3 = clause({ p(f(f(x1))) });
+  Clause* c4 = clause({ ~q(x1) });
+  Clause* c5 = clause({ p(x1) });
+  for (Clause* c : { c1, c2, c3, c4, c5 }) {
+    container.add(c);
+  }
+
+  auto found = candidates(index, clause({ p(c), q(d) }), false);
+  ASS_EQ(found.size(), 3);
+  ALWAYS(found.find(c1));
+  ALWAYS(found.find(c2));
+  ALWAYS(found.find(c5));
+
+  // the polarity of the literals does not restrict subsumption resolution
+  found = candidates(index, clause({ p(c), q(d) }), true);
+  ASS_EQ(found.size(), 4);
+  ALWAYS(found.find(c4));
+
+  container.removedEvent.fire(c1);
+  container.removedEvent.fire(c3);
+  found = candidates(index, clause({ p(f(f(c))), q(d) }), false);
+  ASS_EQ(found.size(), 2);
+  ALWAYS(found.find(c2));
+  ALWAYS(found.find(c5));
+
+  for (Clause* c : { c2, c4, c5 }) {
+    container.removedEvent.fire(c);
+  }
+  ASS(index.isEmpty());
+}
+
+TEST_FUN(forward_index_same_as_filter)
+{
+  SYNTAX_SUGAR_FEATURE_VECTORS;
+
+  // levels of different features, so that they are told apart
+  FwSubsFeatureVectorIndex index({ FeatureVector::NEGATIVE_LITERALS, FeatureVector::LITERAL_SYMBOLS, FeatureVector::POSITIVE_LITERALS });
+  PlainClauseContainer container;
+  index.attachContainer(&container);
+
+  Stack<Clause*> stored = { clause({ p(x1) }), clause({ ~q(x1) }), clause({ p(x1), ~q(f(x1)) }),
+    clause({ p(f(f(x1))), q(x2) }), clause({ ~p(x1), ~r(x2) }), clause({ r(f2(x1, x2)) }) };
+  for (Clause* c : stored) {
+    container.add(c);
+  }
+
+  Stack<Clause*> queries = { clause({ p(c) }), clause({ p(c), ~q(f(c)) }), clause({ ~p(c), ~r(d), q(e) }),
+    clause({ p(f(f(c))), q(d), r(f2(c, d)) }), clause({ ~q(d) }) };
+  for (Clause* query : queries) {
+    for (bool resolution : { false, true }) {
+      auto found = candidates(index, query, resolution);
+      for (Clause* c : stored) {
+        ASS_EQ(found.find(c), resolution ? mayResolve(c, query) : maySubsume(c, query));
+      }
+    }
+  }
+}
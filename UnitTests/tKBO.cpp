@@ -591,3 +591,57 @@ TEST_FUN(kbo_isGreater_test17) {
     f(g(y,f(g(x,g(y,z)))))));
 }
 
+TEST_FUN(ordering_result_cache) {
+  DECL_DEFAULT_VARS
+  DECL_SORT(srt)
+  DECL_FUNC(f, {srt}, srt)
+  DECL_FUNC(g, {srt, srt}, srt)
+  DECL_CONST(c, srt)
+
+  auto ord = kbo(weights(), weights());
+  Stack<TermList> terms = { f(x), g(x, c), f(g(x, y)), g(c, c), f(f(c)), g(y, x) };
+
+  OrderingResultCache cache;
+  cache.init(3);
+  for (auto t1 : terms) {
+    for (auto t2 : terms) {
+      if (t1 == t2) {
+        continue;
+      }
+      Ordering::Result res;
+      if (!cache.find(t1.term(), t2.term(), res)) {
+        res = ord.compare(t1, t2);
+        cache.insert(t1.term(), t2.term(), res);
+        // a pair is stored for both of its orders
+        Ordering::Result rev;
+        ASS(cache.find(t2.term(), t1.term(), rev));
+        ASS_EQ(rev, Ordering::reverse(res));
+      }
+      ASS_EQ(res, ord.compare(t1, t2));
+    }
+  }
+}
+
+TEST_FUN(kbo_variable_summaries) {
+  DECL_DEFAULT_VARS
+  DECL_SORT(srt)
+  DECL_FUNC(f, {srt}, srt)
+  DECL_FUNC(g, {srt, srt}, srt)
+  DECL_CONST(c, srt)
+  // has the same bit in the variable masks as x
+  DECL_VAR(u, 32)
+
+  auto ord = kbo(weights(), weights());
+
+  // each term has a variable the other does not have
+  ASS_EQ(ord.compare(f(x), g(y, y)), Ordering::Result::INCOMPARABLE)
+  // the left term has more variable occurrences
+  ASS_EQ(ord.compare(g(x, x), f(x)), Ordering::Result::GREATER)
+  ASS_EQ(ord.compare(f(g(x, x)), g(f(x), c)), Ordering::Result::INCOMPARABLE)
+  // the right term has a variable the left one does not have
+  ASS_EQ(ord.compare(f(x), g(x, y)), Ordering::Result::LESS)
+  ASS_EQ(ord.compare(g(g(x, c), c), f(g(x, y))), Ordering::Result::INCOMPARABLE)
+  // the variables are told apart by the traversal
+  ASS_EQ(ord.compare(g(x, c), f(u)), Ordering::Result::INCOMPARABLE)
+  ASS_EQ(ord.compare(g(u, c), f(u)), Ordering::Result::GREATER)
+}
@@ -0,0 +1,174 @@
+/*
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ */
+#include "Test/UnitTesting.hpp"
+#include "Test/SyntaxSugar.hpp"
+
+#include "Lib/DHMap.hpp"
+#include "Lib/Deque.hpp"
+#include "Lib/Set.hpp"
+#include "Shell/SineUtils.hpp"
+
+using namespace Shell;
+
+typedef SineSymbolExtractor::SymId SymId;
+
+/**
+ * The SInE selection as it was done before SineTriggerIndex: the D-relation is built
+ * from the symbols of the units for the given parameters, and the units are selected
+ * in rounds from the goals. Returns the selected units in the order they were selected.
+ */
+static Stack<Unit*> referenceSelection(const Stack<Unit*>& units, float tolerance, unsigned depthLimit, unsigned genThreshold)
+{
+  SineSymbolExtractor extractor;
+  DHMap<SymId, unsigned> gen;
+  for (Unit* u : units) {
+    for (SymId sym : iterTraits(extractor.extractSymIds(u))) {
+      unsigned* cnt;
+      gen.getValuePtr(sym, cnt, 0);
+      (*cnt)++;
+    }
+  }
+
+  // the units triggered by each symbol, the last one pushed is the first one selected
+  DHMap<SymId, Stack<Unit*>> def;
+  Set<Unit*> selected;
+  Stack<Unit*> selectedStack;
+  Deque<Unit*> newlySelected;
+  for (Unit* u : units) {
+    if (u->inputType() != UnitInputType::AXIOM) {
+      selected.insert(u);
+      selectedStack.push(u);
+      newlySelected.push_back(u);
+      continue;
+    }
+    Stack<SymId> syms = iterTraits(extractor.extractSymIds(u)).collect<Stack>();
+    unsigned leastGen = UINT_MAX;
+    for (SymId sym : syms) {
+      leastGen = std::min(leastGen, gen.get(sym));
+    }
+    unsigned limit = tolerance == -1.0f ? UINT_MAX : static_cast<unsigned>(leastGen * tolerance);
+    for (SymId sym : syms) {
+      unsigned val = gen.get(sym);
+      if (val <= genThreshold || (tolerance == 1.0f ? val == leastGen : val <= limit)) {
+        Stack<Unit*>* triggered;
+        def.getValuePtr(sym, triggered);
+        triggered->push(u);
+      }
+    }
+  }
+
+  unsigned depth = 0;
+  newlySelected.push_back(nullptr);
+  while (newlySelected.isNonEmpty()) {
+    Unit* u = newlySelected.pop_front();
+    if (!u) {
+      depth++;
+      if (depthLimit && depth == depthLimit) {
+        break;
+      }
+      if (newlySelected.isNonEmpty()) {
+        newlySelected.push_back(nullptr);
+      }
+      continue;
+    }
+    for (SymId sym : iterTraits(extractor.extractSymIds(u))) {
+      Stack<Unit*>* triggered = def.findPtr(sym);
+      if (!triggered) {
+        continue;
+      }
+      for (Unit* du : iterTraits(triggered->iter())) {
+        if (selected.contains(du)) {
+          continue;
+        }
+        selected.insert(du);
+        selectedStack.push(du);
+        newlySelected.push_back(du);
+      }
+      triggered->reset();
+    }
+  }
+  return selectedStack;
+}
+
+/** A deterministic mix of goal and axiom clauses over symbols of various generality */
+static Stack<Unit*> problem()
+{
+  DECL_DEFAULT_VARS
+  DECL_SORT(s)
+  DECL_PRED(p0, {s})
+  DECL_PRED(p1, {s})
+  DECL_PRED(p2, {s})
+  DECL_PRED(p3, {s})
+  DECL_PRED(p4, {s})
+  DECL_PRED(q, {s, s})
+  DECL_CONST(a0, s)
+  DECL_CONST(a1, s)
+  DECL_CONST(a2, s)
+  DECL_CONST(a3, s)
+  DECL_CONST(a4, s)
+  DECL_CONST(a5, s)
+  DECL_FUNC(f, {s}, s)
+
+  PredSugar preds[] = { p0, p1, p2, p3, p4 };
+  TermSugar consts[] = { a0, a1, a2, a3, a4, a5 };
+
+  unsigned seed = 12345;
+  auto next = [&](unsigned bound) {
+    seed = seed * 1103515245 + 12345;
+    return (seed >> 16) % bound;
+  };
+  auto term = [&]() -> TermSugar {
+    switch (next(4)) {
+      case 0: return x;
+      case 1: return f(consts[next(6)]);
+      default: return consts[next(6)];
+    }
+  };
+
+  Stack<Unit*> units;
+  for (unsigned i = 0; i < 60; i++) {
+    Stack<Lit> lits;
+    unsigned length = 1 + next(3);
+    for (unsigned j = 0; j < length; j++) {
+      Lit lit = next(5) ? preds[next(5)](term()) : q(term(), term());
+      lits.push(next(2) ? lit : ~lit);
+    }
+    Clause* cl = clause(lits);
+    cl->setInputType(i < 3 ? UnitInputType::NEGATED_CONJECTURE : UnitInputType::AXIOM);
+    units.push(cl);
+  }
+  return units;
+}
+
+TEST_FUN(same_selection_as_the_d_relation)
+{
+  Stack<Unit*> units = problem();
+
+  for (float tolerance : { 1.0f, 1.2f, 2.0f, 3.0f, -1.0f }) {
+    for (unsigned depthLimit : { 0u, 1u, 2u }) {
+      for (unsigned genThreshold : { 0u, 3u }) {
+        // the same units in the same order every time, so that all but the first selection use the cached index
+        UnitList* list = nullptr;
+        UnitList::pushFromIterator(units.iter(), list);
+        SineSelector(false, tolerance, depthLimit, genThreshold).perform(list);
+
+        Stack<Unit*> expected = referenceSelection(units, tolerance, depthLimit, genThreshold);
+        unsigned i = 0;
+        for (Unit* u : iterTraits(UnitList::Iterator(list))) {
+          ASS_L(i, expected.size())
+          ASS_EQ(u, expected[i])
+          i++;
+        }
+        ASS_EQ(i, expected.size())
+        UnitList::destroy(list);
+      }
+    }
+  }
+}
@@ -0,0 +1,111 @@
+/*
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ */
+#include <thread>
+#include <vector>
+
+#include "Debug/Assertion.hpp"
+#include "Lib/Set.hpp"
+#include "Lib/StripedSet.hpp"
+#include "Test/UnitTesting.hpp"
+
+using StripedUnsigned = StripedSet<unsigned, DefaultHash>;
+
+TEST_FUN(insert_find)
+{
+  StripedUnsigned set;
+  for (unsigned i = 0; i < 1000; i++) {
+    ASS_EQ(set.insert(i), i);
+  }
+  ASS_EQ(set.size(), 1000);
+
+  // inserting again finds the old value
+  for (unsigned i = 0; i < 1000; i++) {
+    set.insert(i);
+  }
+  ASS_EQ(set.size(), 1000);
+
+  unsigned found = 0;
+  ALWAYS(set.find(42u, found));
+  ASS_EQ(found, 42);
+  NEVER(set.find(1000u, found));
+}
+
+TEST_FUN(raw_find_or_insert)
+{
+  StripedUnsigned set;
+  bool inserted;
+  set.rawFindOrInsert([]() { return 7u; }, DefaultHash::hash(7u), [](unsigned v) { return v == 7; }, inserted);
+  ASS(inserted);
+  set.rawFindOrInsert([]() { return 7u; }, DefaultHash::hash(7u), [](unsigned v) { return v == 7; }, inserted);
+  ASS(!inserted);
+  ASS_EQ(set.size(), 1);
+}
+
+TEST_FUN(iteration)
+{
+  StripedUnsigned set;
+  StripedUnsigned::Iterator empty(set);
+  NEVER(empty.hasNext());
+
+  Set<unsigned> expected;
+  for (unsigned i = 0; i < 5000; i += 3) {
+    set.insert(i);
+    expected.insert(i);
+  }
+
+  unsigned count = 0;
+  StripedUnsigned::Iterator it(set);
+  while (it.hasNext()) {
+    ALWAYS(expected.contains(it.next()));
+    count++;
+  }
+  ASS_EQ(count, expected.size());
+  NEVER(it.hasNext());
+}
+
+TEST_FUN(concurrent_insert_find)
+{
+  StripedUnsigned set;
+  // let all the stripes grow once before the threads start
+  for (unsigned i = 0; i < 2000; i++) {
+    set.insert(i);
+  }
+
+  // overlapping ranges, so that the threads also find each other's values
+  const unsigned THREADS = 4;
+  const unsigned PER_THREAD = 20000;
+  std::vector<std::thread> threads;
+  std::vector<unsigned> missed(THREADS, 0);
+  for (unsigned t = 0; t < THREADS; t++) {
+    threads.emplace_back([&set, &missed, t]() {
+      for (unsigned i = t * PER_THREAD / 2; i < (t + 2) * PER_THREAD / 2; i++) {
+        unsigned found;
+        if (set.insert(i) != i || !set.find(i, found) || found != i) {
+          missed[t]++;
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (unsigned t = 0; t < THREADS; t++) {
+    ASS_EQ(missed[t], 0);
+  }
+  ASS_EQ(set.size(), (THREADS + 1) * PER_THREAD / 2);
+  unsigned count = 0;
+  StripedUnsigned::Iterator it(set);
+  while (it.hasNext()) {
+    ASS_L(it.next(), (THREADS + 1) * PER_THREAD / 2);
+    count++;
+  }
+  ASS_EQ(count, set.size());
+}
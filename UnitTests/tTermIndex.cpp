@@ -299,3 +299,103 @@ TEST_FUN(zero_arity_predicate) {
 
 }
 
+
+TEST_FUN(sorted_array_nodes) {
+
+  DECL_DEFAULT_VARS
+  DECL_SORT(srt)
+  DECL_CONST(a, srt)
+  DECL_CONST(b, srt)
+  DECL_CONST(c, srt)
+  DECL_CONST(d, srt)
+  DECL_CONST(e, srt)
+  DECL_CONST(a1, srt)
+  DECL_CONST(a2, srt)
+  DECL_FUNC(f, {srt}, srt)
+  DECL_FUNC(g, {srt}, srt)
+
+  using Data = MyData<TypedTermList>;
+  using Tree = TermSubstitutionTree<Data>;
+  // enough children below f for the node to grow into a sorted array, and beyond its initial capacity
+  Tree tree(Tree::NodeAlgorithm(SubstitutionTree<Data>::SORTED_ARRAY));
+  auto dat = [](TypedTermList k, std::string s) { return Data(k, std::move(s)); };
+  tree.insert(dat(f(a), "f(a)"));
+  tree.insert(dat(f(b), "f(b)"));
+  tree.insert(dat(f(c), "f(c)"));
+  tree.insert(dat(f(d), "f(d)"));
+  tree.insert(dat(f(e), "f(e)"));
+  tree.insert(dat(f(a1), "f(a1)"));
+  tree.insert(dat(f(a2), "f(a2)"));
+  tree.insert(dat(f(f(a)), "f(f(a))"));
+  tree.insert(dat(f(g(a)), "f(g(a))"));
+  tree.insert(dat(f(g(b)), "f(g(b))"));
+  tree.insert(dat(f(f(f(a))), "f(f(f(a)))"));
+  tree.insert(dat(f(x), "f(x)"));
+
+  check_unify(tree, f(c), { dat(f(c), "f(c)"), dat(f(x), "f(x)") });
+  check_unify(tree, f(g(y)), { dat(f(g(a)), "f(g(a))"), dat(f(g(b)), "f(g(b))"), dat(f(x), "f(x)") });
+  check_gen(tree, f(d), { dat(f(d), "f(d)"), dat(f(x), "f(x)") });
+  check_gen(tree, f(f(a)), { dat(f(f(a)), "f(f(a))"), dat(f(x), "f(x)") });
+  check_inst(tree, f(g(y)), { dat(f(g(a)), "f(g(a))"), dat(f(g(b)), "f(g(b))") });
+  check_inst(tree, f(y), {
+      dat(f(a), "f(a)"), dat(f(b), "f(b)"), dat(f(c), "f(c)"), dat(f(d), "f(d)"), dat(f(e), "f(e)"),
+      dat(f(a1), "f(a1)"), dat(f(a2), "f(a2)"), dat(f(f(a)), "f(f(a))"), dat(f(g(a)), "f(g(a))"), dat(f(g(b)), "f(g(b))"), dat(f(f(f(a))), "f(f(f(a)))"),
+      dat(f(x), "f(x)") });
+
+  tree.remove(dat(f(x), "f(x)"));
+  tree.remove(dat(f(c), "f(c)"));
+  tree.remove(dat(f(g(a)), "f(g(a))"));
+  check_unify(tree, f(c), Stack<Data>{});
+  check_unify(tree, f(g(y)), { dat(f(g(b)), "f(g(b))") });
+  check_gen(tree, f(d), { dat(f(d), "f(d)") });
+  check_inst(tree, f(y), {
+      dat(f(a), "f(a)"), dat(f(b), "f(b)"), dat(f(d), "f(d)"), dat(f(e), "f(e)"),
+      dat(f(a1), "f(a1)"), dat(f(a2), "f(a2)"), dat(f(f(a)), "f(f(a))"), dat(f(g(b)), "f(g(b))"), dat(f(f(f(a))), "f(f(f(a)))") });
+}
+
+TEST_FUN(batch_unify) {
+
+  DECL_DEFAULT_VARS
+  DECL_SORT(srt)
+  DECL_CONST(a, srt)
+  DECL_CONST(b, srt)
+  DECL_FUNC(f, {srt}, srt)
+  DECL_FUNC(g, {srt, srt}, srt)
+
+  using Data = MyData<TypedTermList>;
+  TermSubstitutionTree<Data> tree;
+  auto dat = [](TypedTermList k, std::string s) { return Data(k, std::move(s)); };
+  tree.insert(dat(f(a), "f(a)"));
+  tree.insert(dat(f(b), "f(b)"));
+  tree.insert(dat(f(x), "f(x)"));
+  tree.insert(dat(g(a, b), "g(a, b)"));
+  tree.insert(dat(g(x, x), "g(x, x)"));
+  tree.insert(dat(g(f(x), y), "g(f(x), y)"));
+  tree.insert(dat(a, "a"));
+
+  // f(y) occurs twice, b unifies with nothing
+  Stack<TypedTermList> queries { f(y), g(y, b), f(a), g(a, a), f(y), b, g(f(a), f(z)) };
+  auto uwa = Options::UnificationWithAbstraction::OFF;
+
+  Stack<Stack<Data>> is;
+  for (unsigned i = 0; i < queries.size(); i++) {
+    is.push(Stack<Data>());
+  }
+  for (auto res : iterTraits(tree.getUwaBatch(queries, uwa, /* fixedPointIteration */ false))) {
+    auto& subs = res.second.unifier->subs();
+    ASS_EQ(subs.apply(TermList(queries[res.first]), subsTreeQueryBank(0)), subs.apply(TermList(res.second.data->term), subsTreeInternalBank(0)));
+    is[res.first].push(*res.second.data);
+  }
+
+  for (unsigned i = 0; i < queries.size(); i++) {
+    auto expected = iterTraits(tree.getUwa(queries[i], uwa, /* fixedPointIteration */ false))
+      .map([](auto qr) { return *qr.data; })
+      .template collect<Stack>();
+    std::sort(is[i].begin(), is[i].end());
+    std::sort(expected.begin(), expected.end());
+    ASS_EQ(is[i], expected);
+  }
+  ASS_EQ(is[0].size(), 3);
+  ASS_EQ(is[4], is[0]);
+  ASS(is[5].isEmpty());
+}
@@ -39,10 +39,15 @@ set(UNIT_TESTS
     UnitTests/tALASCA_TermFactoring.cpp
     UnitTests/tALASCA_VIRAS.cpp
     UnitTests/tALASCA_VariableElimination.cpp
+    UnitTests/tAllocator.cpp
+    UnitTests/tAxiomSnapshot.cpp
     UnitTests/tArithCompare.cpp
     UnitTests/tArithmeticSubtermGeneralization.cpp
     UnitTests/tBinaryHeap.cpp
     UnitTests/tBottomUpEvaluation.cpp
+    UnitTests/tBucketClauseQueue.cpp
+    UnitTests/tClauseVariantIndex.cpp
+    UnitTests/tCompactClause.cpp
     UnitTests/tCoproduct.cpp
     UnitTests/tDHMap.cpp
     UnitTests/tDHMultiset.cpp
@@ -50,6 +55,7 @@ set(UNIT_TESTS
     UnitTests/tDisagreement.cpp
     UnitTests/tDynamicHeap.cpp
     UnitTests/tEqualityResolution.cpp
+    UnitTests/tFeatureVectorIndex.cpp
     UnitTests/tFunctionDefinitionHandler.cpp
     UnitTests/tFunctionDefinitionRewriting.cpp
     UnitTests/tGaussianElimination.cpp
@@ -74,8 +80,10 @@ set(UNIT_TESTS
     UnitTests/tSKIKBO.cpp
     UnitTests/tSafeRecursion.cpp
     UnitTests/tSet.cpp
+    UnitTests/tSineSelection.cpp
     UnitTests/tSkipList.cpp
     UnitTests/tStack.cpp
+    UnitTests/tStripedSet.cpp
     UnitTests/tSyntaxSugar.cpp
     UnitTests/tTermAlgebra.cpp
     UnitTests/tTermIndex.cpp
@@ -139,6 +147,8 @@ set(SOURCES
     Indexing/CodeTree.hpp
     Indexing/CodeTreeInterfaces.cpp
     Indexing/CodeTreeInterfaces.hpp
+    Indexing/FeatureVectorIndex.cpp
+    Indexing/FeatureVectorIndex.hpp
     Indexing/Index.cpp
     Indexing/Index.hpp
     Indexing/IndexManager.cpp
@@ -263,6 +273,8 @@ set(SOURCES
     Inferences/Factoring.hpp
     Inferences/FastCondensation.cpp
     Inferences/FastCondensation.hpp
+    Inferences/FeatureVectorForwardSubsumptionAndResolution.cpp
+    Inferences/FeatureVectorForwardSubsumptionAndResolution.hpp
     Inferences/ForwardDemodulation.cpp
     Inferences/ForwardDemodulation.hpp
     Inferences/ForwardLiteralRewriting.cpp
@@ -336,11 +348,12 @@ set(SOURCES
     Kernel/ApplicativeHelper.hpp
     Kernel/BestLiteralSelector.hpp
     Kernel/BottomUpEvaluation.hpp
+    Kernel/BucketClauseQueue.hpp
     Kernel/Clause.cpp
     Kernel/Clause.hpp
-    Kernel/ClauseQueue.cpp
-    Kernel/ClauseQueue.hpp
     Kernel/ColorHelper.hpp
+    Kernel/CompactClause.cpp
+    Kernel/CompactClause.hpp
     Kernel/Connective.hpp
     Kernel/ELiteralSelector.cpp
     Kernel/ELiteralSelector.hpp
@@ -526,8 +539,11 @@ set(SOURCES
     Lib/Stack.hpp
     Lib/StringUtils.cpp
     Lib/StringUtils.hpp
+    Lib/StripedSet.hpp
     Lib/Sys/Multiprocessing.cpp
     Lib/Sys/Multiprocessing.hpp
+    Lib/Sys/SpillFile.cpp
+    Lib/Sys/SpillFile.hpp
     Lib/System.cpp
     Lib/System.hpp
     Lib/Timer.cpp
@@ -618,6 +634,8 @@ set(SOURCES
     Saturation/LRS.hpp
     Saturation/LabelFinder.cpp
     Saturation/LabelFinder.hpp
+    Saturation/LemmaExchange.cpp
+    Saturation/LemmaExchange.hpp
     Saturation/ManCSPassiveClauseContainer.cpp
     Saturation/ManCSPassiveClauseContainer.hpp
     Saturation/Otter.cpp
@@ -634,6 +652,8 @@ set(SOURCES
     Saturation/SymElOutput.hpp
     Shell/AnswerLiteralManager.cpp
     Shell/AnswerLiteralManager.hpp
+    Shell/AxiomSnapshot.cpp
+    Shell/AxiomSnapshot.hpp
     Shell/BlockedClauseElimination.cpp
     Shell/BlockedClauseElimination.hpp
     Shell/CNF.cpp
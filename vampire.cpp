@@ -41,6 +41,7 @@
 #include "Inferences/TautologyDeletionISE.hpp"
 
 #include "CASC/PortfolioMode.hpp"
+#include "Shell/AxiomSnapshot.hpp"
 #include "Shell/CommandLine.hpp"
 #include "Shell/Normalisation.hpp"
 #include "Shell/Options.hpp"
@@ -491,6 +492,11 @@ void clausifyMode(Problem* problem, bool theory)
 
   if (env.options->latexOutput() != "off") { outputClausesToLaTeX(prb.ptr()); }
 
+  if (!env.options->axiomSnapshot().empty()) {
+    AxiomSnapshot::save(env.options->axiomSnapshot(),
+      pvi(iterTraits(prb->clauseIterator()).filter([](Clause* cl) { return !cl->derivedFromGoal(); })));
+  }
+
   //we have successfully output all clauses, so we'll terminate with zero return value
   vampireReturnValue = VAMP_RESULT_STATUS_SUCCESS;
 } // clausifyMode
@@ -771,6 +777,9 @@ int main(int argc, char* argv[])
         UIHelper::parseFile(opts.inputFile(),opts.inputSyntax(),
                             opts.mode() != Options::Mode::SPIDER && opts.mode() != Options::Mode::PROFILE);
       }
+      if (!opts.axiomSnapshot().empty() && opts.mode() != Options::Mode::CLAUSIFY && opts.mode() != Options::Mode::TCLAUSIFY) {
+        UIHelper::loadAxiomSnapshot(opts.axiomSnapshot());
+      }
 
 #if VAMPIRE_PERF_EXISTS
       if (env.options->parsingDoesNotCount()) {